@@ -0,0 +1,267 @@
+// source/anim/AnimationClip.cpp
+#include "anim/AnimationClip.hpp"
+#include "core/Logging.hpp"
+#include "core/SimdMath.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/* ------------------------------ quantisation --------------------------- */
+namespace {
+
+constexpr float kSqrtHalf = 0.70710678f;
+
+// Smallest-three: drop the largest component (its sign is forced positive
+// and its magnitude recovered from the unit length), store the other three
+// in 15 bits each and spread the dropped index over the two spare bits.
+uint16_t quantUnit15(float v)
+{
+    float n = (v / kSqrtHalf) * 0.5f + 0.5f;
+    return uint16_t(std::clamp(n, 0.f, 1.f) * 32767.f + 0.5f);
+}
+
+inline float dequantUnit15(uint16_t v)
+{
+    constexpr float kScale = 2.f * kSqrtHalf / 32767.f;
+    return float(v & 0x7FFF) * kScale - kSqrtHalf;
+}
+
+template <class Key>
+Key encodeQuat(const glm::quat& q)
+{
+    float c[4] = { q.x, q.y, q.z, q.w };
+    int big = 0;
+    for (int i = 1; i < 4; ++i)
+        if (std::fabs(c[i]) > std::fabs(c[big]))
+            big = i;
+    float sign = c[big] < 0.f ? -1.f : 1.f;
+
+    Key k;
+    for (int i = 0, o = 0; i < 4; ++i)
+        if (i != big)
+            k.v[o++] = quantUnit15(c[i] * sign);
+    k.v[0] |= uint16_t((big & 1) << 15);
+    k.v[1] |= uint16_t((big >> 1) << 15);
+    return k;
+}
+
+template <class Key>
+inline glm::quat decodeQuat(const Key& k)
+{
+    int big = (k.v[0] >> 15) | ((k.v[1] >> 15) << 1);
+    float a = dequantUnit15(k.v[0]);
+    float b = dequantUnit15(k.v[1]);
+    float c = dequantUnit15(k.v[2]);
+    float d = std::sqrt(std::max(0.f, 1.f - a * a - b * b - c * c));
+    switch (big) { // glm::quat takes w first
+    case 0:
+        return glm::quat(c, d, a, b);
+    case 1:
+        return glm::quat(c, a, d, b);
+    case 2:
+        return glm::quat(c, a, b, d);
+    default:
+        return glm::quat(d, a, b, c);
+    }
+}
+
+// `step` is the range extent divided by 65535, i.e. the value of one LSB.
+template <class Key>
+Key encodeVec(const glm::vec3& v, const glm::vec3& min, const glm::vec3& step)
+{
+    Key k;
+    for (int i = 0; i < 3; ++i) {
+        float n = step[i] > 0.f ? (v[i] - min[i]) / step[i] : 0.f;
+        k.v[i] = uint16_t(std::clamp(n, 0.f, 65535.f) + 0.5f);
+    }
+    return k;
+}
+
+template <class Key>
+inline glm::vec3 decodeVec(const Key& k, const glm::vec3& min, const glm::vec3& step)
+{
+    return min + glm::vec3(k.v[0], k.v[1], k.v[2]) * step;
+}
+
+float quatError(const glm::quat& a, const glm::quat& b)
+{
+    float d = std::min(1.f, std::fabs(glm::dot(a, b)));
+    return 2.f * std::acos(d);
+}
+
+float vecError(const glm::vec3& a, const glm::vec3& b)
+{
+    return glm::length(a - b);
+}
+
+/*
+ * Greedy piecewise-linear fit. `decoded` holds every frame after
+ * quantisation, `raw` the source; a segment is accepted while every
+ * frame it skips reconstructs within `tolerance`. Returns kept frames.
+ */
+template <class T, class Lerp, class Err>
+std::vector<uint16_t> fitKeys(const std::vector<T>& decoded, const std::vector<T>& raw,
+    float tolerance, Lerp lerp, Err error)
+{
+    const std::size_t n = raw.size();
+
+    bool constant = true;
+    for (std::size_t i = 1; i < n && constant; ++i)
+        constant = error(decoded[0], raw[i]) <= tolerance;
+    if (constant)
+        return { 0 };
+
+    auto fits = [&](std::size_t a, std::size_t c) {
+        for (std::size_t i = a + 1; i < c; ++i) {
+            float t = float(i - a) / float(c - a);
+            if (error(lerp(decoded[a], decoded[c], t), raw[i]) > tolerance)
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<uint16_t> keys { 0 };
+    std::size_t a = 0;
+    while (a + 1 < n) {
+        std::size_t b = a + 1;
+        while (b + 1 < n && fits(a, b + 1))
+            ++b;
+        keys.push_back(uint16_t(b));
+        a = b;
+    }
+    return keys;
+}
+
+// Locate the key pair around `frame` and the blend factor between them.
+inline void findSegment(const uint16_t* frames, uint32_t count, float frame,
+    uint32_t& k0, uint32_t& k1, float& t)
+{
+    if (count == 1 || frame <= frames[0]) {
+        k0 = k1 = 0;
+        t = 0.f;
+        return;
+    }
+    const uint16_t* it = std::upper_bound(frames, frames + count, uint16_t(frame));
+    k1 = uint32_t(it - frames);
+    if (k1 >= count) {
+        k0 = k1 = count - 1;
+        t = 0.f;
+        return;
+    }
+    k0 = k1 - 1;
+    t = (frame - frames[k0]) / float(frames[k1] - frames[k0]);
+}
+
+} // namespace
+
+/* -------------------------------- build -------------------------------- */
+
+bool AnimationClip::build(const RawClip& raw, const ClipCompression& settings)
+{
+    const std::size_t frameCount = raw.frames.size();
+    if (frameCount == 0 || frameCount > 0xFFFF || raw.frameRate <= 0.f) {
+        LOG_ERROR("AnimationClip: bad frame count %zu", frameCount);
+        return false;
+    }
+    const std::size_t joints = raw.frames[0].size();
+    for (const Pose& p : raw.frames)
+        if (p.size() != joints) {
+            LOG_ERROR("AnimationClip: frames have differing joint counts");
+            return false;
+        }
+
+    *this = AnimationClip();
+    m_frameRate = raw.frameRate;
+    m_duration = float(frameCount - 1) / raw.frameRate;
+    m_rotTracks.resize(joints);
+    m_transTracks.resize(joints);
+    m_scaleTracks.resize(joints);
+    m_transRanges.resize(joints);
+    m_scaleRanges.resize(joints);
+
+    auto vecLerp = [](const glm::vec3& a, const glm::vec3& b, float t) {
+        return a + (b - a) * t;
+    };
+
+    std::vector<glm::quat> rawRot(frameCount), decRot(frameCount);
+    std::vector<glm::vec3> rawVec(frameCount), decVec(frameCount);
+
+    for (std::size_t j = 0; j < joints; ++j) {
+        // rotations
+        for (std::size_t f = 0; f < frameCount; ++f) {
+            rawRot[f] = raw.frames[f].rotations[j];
+            decRot[f] = decodeQuat(encodeQuat<Key48>(rawRot[f]));
+        }
+        auto keys = fitKeys(decRot, rawRot, settings.rotationError, simd::nlerp, quatError);
+        m_rotTracks[j] = { uint32_t(m_rotKeys.size()), uint32_t(keys.size()) };
+        for (uint16_t f : keys) {
+            m_rotFrames.push_back(f);
+            m_rotKeys.push_back(encodeQuat<Key48>(rawRot[f]));
+        }
+
+        // translations and scales share the range-quantised path
+        auto packVec = [&](auto member, float tolerance, Track& track, Range& range,
+                           std::vector<uint16_t>& frames, std::vector<Key48>& pool) {
+            glm::vec3 lo(1e30f), hi(-1e30f);
+            for (std::size_t f = 0; f < frameCount; ++f) {
+                rawVec[f] = (raw.frames[f].*member)[j];
+                lo = glm::min(lo, rawVec[f]);
+                hi = glm::max(hi, rawVec[f]);
+            }
+            range = { lo, (hi - lo) / 65535.f };
+            for (std::size_t f = 0; f < frameCount; ++f)
+                decVec[f] = decodeVec(encodeVec<Key48>(rawVec[f], range.min, range.step),
+                    range.min, range.step);
+            auto kept = fitKeys(decVec, rawVec, tolerance, vecLerp, vecError);
+            track = { uint32_t(pool.size()), uint32_t(kept.size()) };
+            for (uint16_t f : kept) {
+                frames.push_back(f);
+                pool.push_back(encodeVec<Key48>(rawVec[f], range.min, range.step));
+            }
+        };
+        packVec(&Pose::translations, settings.translationError, m_transTracks[j],
+            m_transRanges[j], m_transFrames, m_transKeys);
+        packVec(&Pose::scales, settings.scaleError, m_scaleTracks[j],
+            m_scaleRanges[j], m_scaleFrames, m_scaleKeys);
+    }
+    return true;
+}
+
+std::size_t AnimationClip::sizeInBytes() const
+{
+    std::size_t keys = m_rotKeys.size() + m_transKeys.size() + m_scaleKeys.size();
+    return keys * (sizeof(Key48) + sizeof(uint16_t))
+        + jointCount() * (3 * sizeof(Track) + 2 * sizeof(Range));
+}
+
+/* ------------------------------- sampling ------------------------------ */
+
+void AnimationClip::sample(float time, Pose& out) const
+{
+    const std::size_t joints = jointCount();
+    out.resize(joints);
+    float frame = std::clamp(time, 0.f, m_duration) * m_frameRate;
+
+    uint32_t k0, k1;
+    float t;
+    for (std::size_t j = 0; j < joints; ++j) {
+        const Track& r = m_rotTracks[j];
+        findSegment(&m_rotFrames[r.first], r.count, frame, k0, k1, t);
+        glm::quat q0 = decodeQuat(m_rotKeys[r.first + k0]);
+        out.rotations[j] = k0 == k1 ? q0 : simd::nlerp(q0, decodeQuat(m_rotKeys[r.first + k1]), t);
+
+        const Track& tr = m_transTracks[j];
+        const Range& trr = m_transRanges[j];
+        findSegment(&m_transFrames[tr.first], tr.count, frame, k0, k1, t);
+        glm::vec3 p0 = decodeVec(m_transKeys[tr.first + k0], trr.min, trr.step);
+        glm::vec3 p1 = decodeVec(m_transKeys[tr.first + k1], trr.min, trr.step);
+        out.translations[j] = p0 + (p1 - p0) * t;
+
+        const Track& s = m_scaleTracks[j];
+        const Range& sr = m_scaleRanges[j];
+        findSegment(&m_scaleFrames[s.first], s.count, frame, k0, k1, t);
+        glm::vec3 s0 = decodeVec(m_scaleKeys[s.first + k0], sr.min, sr.step);
+        glm::vec3 s1 = decodeVec(m_scaleKeys[s.first + k1], sr.min, sr.step);
+        out.scales[j] = s0 + (s1 - s0) * t;
+    }
+}
@@ -0,0 +1,63 @@
+// source/anim/AnimationClip.hpp
+#pragma once
+#include "anim/Pose.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Uncompressed clip as authored: one full local pose per frame. */
+struct RawClip {
+    float frameRate { 30.f };
+    std::vector<Pose> frames;
+};
+
+/* Maximum deviation allowed when dropping keys. */
+struct ClipCompression {
+    float rotationError { 0.001f }; // radians
+    float translationError { 0.0005f }; // model units
+    float scaleError { 0.0005f };
+};
+
+/*
+ * Compressed, immutable animation clip.
+ *
+ * Rotations are stored smallest-three (48 bits per key), translations
+ * and scales as 16-bit values inside a per-track bounding range. Each
+ * track keeps only the frames a piecewise-linear fit needs to stay within
+ * ClipCompression of the source, so static or linear channels collapse to
+ * one or two keys.
+ */
+class AnimationClip {
+public:
+    bool build(const RawClip& raw, const ClipCompression& settings = {});
+
+    /* Samples the local pose at `time` seconds (clamped to the clip). */
+    void sample(float time, Pose& out) const;
+
+    float duration() const { return m_duration; }
+    std::size_t jointCount() const { return m_rotTracks.size(); }
+    std::size_t sizeInBytes() const;
+
+private:
+    struct Track {
+        uint32_t first; // index of the first key in the pool
+        uint32_t count;
+    };
+    struct Key48 {
+        uint16_t v[3];
+    };
+    struct Range {
+        glm::vec3 min;
+        glm::vec3 step; // extent / 65535
+    };
+
+    float m_frameRate { 30.f };
+    float m_duration { 0.f };
+
+    std::vector<Track> m_rotTracks, m_transTracks, m_scaleTracks;
+    std::vector<Range> m_transRanges, m_scaleRanges;
+
+    // key pools: frame numbers and quantised values side by side
+    std::vector<uint16_t> m_rotFrames, m_transFrames, m_scaleFrames;
+    std::vector<Key48> m_rotKeys, m_transKeys, m_scaleKeys;
+};
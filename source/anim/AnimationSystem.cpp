@@ -0,0 +1,44 @@
+// source/anim/AnimationSystem.cpp
+#include "anim/AnimationSystem.hpp"
+#include "anim/Animator.hpp"
+#include "core/JobSystem.hpp"
+
+#include <algorithm>
+
+AnimationSystem::AnimationSystem(JobSystem* jobs)
+    : m_jobs(jobs)
+{
+}
+
+void AnimationSystem::add(Animator* animator)
+{
+    m_animators.push_back(animator);
+}
+
+void AnimationSystem::remove(Animator* animator)
+{
+    // swap-remove: evaluation order does not matter
+    auto it = std::find(m_animators.begin(), m_animators.end(), animator);
+    if (it != m_animators.end()) {
+        *it = m_animators.back();
+        m_animators.pop_back();
+    }
+}
+
+void AnimationSystem::evaluateRange(std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; ++i)
+        m_animators[i]->evaluate();
+}
+
+void AnimationSystem::update(float dt)
+{
+    for (Animator* a : m_animators)
+        a->advance(dt);
+
+    if (m_jobs)
+        m_jobs->parallelFor(m_animators.size(), kBatchGrain,
+            [this](std::size_t b, std::size_t e) { evaluateRange(b, e); });
+    else
+        evaluateRange(0, m_animators.size());
+}
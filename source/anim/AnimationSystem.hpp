@@ -0,0 +1,34 @@
+// source/anim/AnimationSystem.hpp
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class Animator;
+class JobSystem;
+
+/*
+ * Drives every Animator once per frame: advances playback, then samples,
+ * blends, converts to model space and builds skinning palettes for all
+ * of them as one batch. With a JobSystem the batch is split across the
+ * worker cores; animators are independent so no locking is needed.
+ */
+class AnimationSystem {
+public:
+    explicit AnimationSystem(JobSystem* jobs = nullptr);
+
+    void add(Animator* animator);
+    void remove(Animator* animator);
+
+    void update(float dt);
+
+    std::size_t count() const { return m_animators.size(); }
+
+    // animators per job chunk; small enough to balance uneven rigs
+    static constexpr std::size_t kBatchGrain = 8;
+
+private:
+    void evaluateRange(std::size_t begin, std::size_t end);
+
+    JobSystem* m_jobs;
+    std::vector<Animator*> m_animators;
+};
@@ -0,0 +1,87 @@
+// source/anim/Animator.cpp
+#include "anim/Animator.hpp"
+#include "anim/AnimationClip.hpp"
+#include "anim/AnimationSystem.hpp"
+#include "anim/Skeleton.hpp"
+
+#include <cmath>
+
+Animator::Animator(GameObject* owner, AnimationSystem* system, const Skeleton* skeleton)
+    : Component(owner)
+    , m_system(system)
+    , m_skeleton(skeleton)
+{
+    const std::size_t n = skeleton->jointCount();
+    m_local = skeleton->bindPose;
+    m_scratch.resize(n);
+    m_model.resize(n, glm::mat4(1.f));
+    m_palette.resize(n, glm::mat4(1.f));
+    m_system->add(this);
+}
+
+Animator::~Animator()
+{
+    m_system->remove(this);
+}
+
+void Animator::play(const AnimationClip* clip, float speed, bool loop)
+{
+    m_current = { clip, 0.f, speed, loop };
+    m_next = {};
+    m_fade = 0.f;
+    m_fadeRate = 0.f;
+}
+
+void Animator::crossFade(const AnimationClip* clip, float duration, float speed, bool loop)
+{
+    if (!m_current.clip || duration <= 0.f) {
+        play(clip, speed, loop);
+        return;
+    }
+    m_next = { clip, 0.f, speed, loop };
+    m_fade = 0.f;
+    m_fadeRate = 1.f / duration;
+}
+
+static void advanceLayer(float dt, float duration, float& time, float speed, bool loop)
+{
+    time += dt * speed;
+    if (loop && duration > 0.f) {
+        time = std::fmod(time, duration);
+        if (time < 0.f)
+            time += duration;
+    }
+}
+
+void Animator::advance(float dt)
+{
+    if (m_current.clip)
+        advanceLayer(dt, m_current.clip->duration(), m_current.time,
+            m_current.speed, m_current.loop);
+    if (m_next.clip) {
+        advanceLayer(dt, m_next.clip->duration(), m_next.time, m_next.speed, m_next.loop);
+        m_fade += dt * m_fadeRate;
+        if (m_fade >= 1.f) {
+            m_current = m_next;
+            m_next = {};
+            m_fade = 0.f;
+        }
+    }
+}
+
+void Animator::evaluate()
+{
+    // clips without a skeleton match are skipped rather than read past the end
+    const std::size_t n = m_skeleton->jointCount();
+    auto usable = [n](const AnimationClip* c) { return c && c->jointCount() == n; };
+
+    if (usable(m_current.clip))
+        m_current.clip->sample(m_current.time, m_local);
+    if (usable(m_next.clip)) {
+        m_next.clip->sample(m_next.time, m_scratch);
+        blendPoses(m_local, m_scratch, m_fade, m_local);
+    }
+
+    localToModel(m_local, m_skeleton->parents.data(), m_model.data());
+    buildSkinningPalette(m_model.data(), m_skeleton->inverseBind.data(), n, m_palette.data());
+}
@@ -0,0 +1,60 @@
+// source/anim/Animator.hpp
+#pragma once
+#include "anim/Pose.hpp"
+#include "core/Component.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+class AnimationClip;
+class AnimationSystem;
+struct Skeleton;
+
+/*
+ * Plays up to two clips on a skeleton and cross-fades between them. The
+ * component itself only holds playback state; AnimationSystem samples and
+ * skins every registered Animator in one batched pass per frame.
+ */
+class Animator : public Component {
+public:
+    Animator(GameObject* owner, AnimationSystem* system, const Skeleton* skeleton);
+    ~Animator() override;
+
+    ComponentTypeID type() const override { return componentTypeID<Animator>(); }
+
+    /* Start `clip` immediately, dropping any fade in progress. */
+    void play(const AnimationClip* clip, float speed = 1.f, bool loop = true);
+
+    /* Blend from the current clip to `clip` over `duration` seconds. */
+    void crossFade(const AnimationClip* clip, float duration,
+        float speed = 1.f, bool loop = true);
+
+    const Skeleton* skeleton() const { return m_skeleton; }
+
+    /* Results of the last AnimationSystem::update. */
+    const std::vector<glm::mat4>& modelPose() const { return m_model; }
+    const std::vector<glm::mat4>& skinningPalette() const { return m_palette; }
+
+private:
+    friend class AnimationSystem;
+
+    struct Layer {
+        const AnimationClip* clip { nullptr };
+        float time { 0.f };
+        float speed { 1.f };
+        bool loop { true };
+    };
+
+    void advance(float dt);
+    void evaluate();
+
+    AnimationSystem* m_system;
+    const Skeleton* m_skeleton;
+
+    Layer m_current, m_next; // m_next is only live during a fade
+    float m_fade { 0.f }; // 0 = current only, 1 = next only
+    float m_fadeRate { 0.f };
+
+    // per-instance scratch, sized once so evaluation never allocates
+    Pose m_local, m_scratch;
+    std::vector<glm::mat4> m_model, m_palette;
+};
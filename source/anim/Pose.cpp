@@ -0,0 +1,52 @@
+// source/anim/Pose.cpp
+#include "anim/Pose.hpp"
+#include "core/SimdMath.hpp"
+
+void blendPoses(const Pose& a, const Pose& b, float weight, Pose& out)
+{
+    const std::size_t n = a.size();
+    out.resize(n);
+    if (n == 0)
+        return;
+    for (std::size_t i = 0; i < n; ++i)
+        out.rotations[i] = simd::nlerp(a.rotations[i], b.rotations[i], weight);
+
+    // translations and scales are plain float streams: blend them flat
+    const float* ta = &a.translations[0].x;
+    const float* tb = &b.translations[0].x;
+    float* to = &out.translations[0].x;
+    const float* sa = &a.scales[0].x;
+    const float* sb = &b.scales[0].x;
+    float* so = &out.scales[0].x;
+    std::size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + 4 <= n * 3; i += 4) {
+        float32x4_t va = vld1q_f32(ta + i);
+        vst1q_f32(to + i, vfmaq_n_f32(va, vsubq_f32(vld1q_f32(tb + i), va), weight));
+        float32x4_t vs = vld1q_f32(sa + i);
+        vst1q_f32(so + i, vfmaq_n_f32(vs, vsubq_f32(vld1q_f32(sb + i), vs), weight));
+    }
+#endif
+    for (; i < n * 3; ++i) {
+        to[i] = ta[i] + (tb[i] - ta[i]) * weight;
+        so[i] = sa[i] + (sb[i] - sa[i]) * weight;
+    }
+}
+
+void localToModel(const Pose& local, const int16_t* parents, glm::mat4* model)
+{
+    for (std::size_t i = 0; i < local.size(); ++i) {
+        glm::mat4 m = simd::compose(local.translations[i], local.rotations[i], local.scales[i]);
+        if (parents[i] < 0)
+            model[i] = m;
+        else
+            simd::mul(model[parents[i]], m, model[i]);
+    }
+}
+
+void buildSkinningPalette(const glm::mat4* model, const glm::mat4* inverseBind,
+    std::size_t count, glm::mat4* palette)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        simd::mul(model[i], inverseBind[i], palette[i]);
+}
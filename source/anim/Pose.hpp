@@ -0,0 +1,35 @@
+// source/anim/Pose.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+/* Joint-local transforms of one skeleton, stored as parallel arrays. */
+struct Pose {
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> scales;
+
+    void resize(std::size_t jointCount)
+    {
+        rotations.resize(jointCount);
+        translations.resize(jointCount);
+        scales.resize(jointCount);
+    }
+    std::size_t size() const { return rotations.size(); }
+};
+
+/* out = lerp(a, b, weight) per joint; out may alias a or b. */
+void blendPoses(const Pose& a, const Pose& b, float weight, Pose& out);
+
+/*
+ * Concatenates local transforms down the hierarchy into model space.
+ * parents[i] is -1 for roots and always < i.
+ */
+void localToModel(const Pose& local, const int16_t* parents, glm::mat4* model);
+
+/* palette[i] = model[i] * inverseBind[i] */
+void buildSkinningPalette(const glm::mat4* model, const glm::mat4* inverseBind,
+    std::size_t count, glm::mat4* palette);
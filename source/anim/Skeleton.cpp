@@ -0,0 +1,32 @@
+// source/anim/Skeleton.cpp
+#include "anim/Skeleton.hpp"
+#include "core/Logging.hpp"
+
+int Skeleton::findJoint(std::string_view name) const
+{
+    for (std::size_t i = 0; i < names.size(); ++i)
+        if (names[i] == name)
+            return int(i);
+    return -1;
+}
+
+bool Skeleton::validate() const
+{
+    const std::size_t n = jointCount();
+    if (n == 0 || n > 0x7FFF) {
+        LOG_ERROR("Skeleton: invalid joint count %zu", n);
+        return false;
+    }
+    if (names.size() != n || inverseBind.size() != n || bindPose.size() != n) {
+        LOG_ERROR("Skeleton: array sizes disagree (%zu joints)", n);
+        return false;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (parents[i] >= int(i)) {
+            LOG_ERROR("Skeleton: joint %zu (%s) listed before its parent",
+                i, names[i].c_str());
+            return false;
+        }
+    }
+    return true;
+}
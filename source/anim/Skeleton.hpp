@@ -0,0 +1,24 @@
+// source/anim/Skeleton.hpp
+#pragma once
+#include "anim/Pose.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Joint hierarchy in parent-before-child order, so a single forward pass
+ * can build model-space transforms.
+ */
+struct Skeleton {
+    std::vector<std::string> names;
+    std::vector<int16_t> parents; // -1 for roots
+    std::vector<glm::mat4> inverseBind; // model space -> joint space
+    Pose bindPose; // joint-local rest pose
+
+    std::size_t jointCount() const { return parents.size(); }
+
+    int findJoint(std::string_view name) const;
+
+    /* Checks array sizes and parent ordering; logs the first problem. */
+    bool validate() const;
+};
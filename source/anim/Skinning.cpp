@@ -0,0 +1,51 @@
+// source/anim/Skinning.cpp
+#include "anim/Skinning.hpp"
+#include "core/SimdMath.hpp"
+
+static_assert(sizeof(SkinnedVertex) == 32, "SkinnedVertex must stay GPU-packed");
+
+void skinVertices(const SkinnedVertex* in, std::size_t count,
+    const glm::mat4* palette, SkinnedOutput* out)
+{
+    constexpr float kInv255 = 1.f / 255.f;
+
+    for (std::size_t v = 0; v < count; ++v) {
+        const SkinnedVertex& src = in[v];
+#if defined(__ARM_NEON)
+        // blend the four palette matrices column by column
+        float32x4_t c0 = vdupq_n_f32(0.f), c1 = c0, c2 = c0, c3 = c0;
+        for (int k = 0; k < 4; ++k) {
+            if (src.weights[k] == 0)
+                continue;
+            const float* m = &palette[src.joints[k]][0][0];
+            float w = src.weights[k] * kInv255;
+            c0 = vfmaq_n_f32(c0, vld1q_f32(m + 0), w);
+            c1 = vfmaq_n_f32(c1, vld1q_f32(m + 4), w);
+            c2 = vfmaq_n_f32(c2, vld1q_f32(m + 8), w);
+            c3 = vfmaq_n_f32(c3, vld1q_f32(m + 12), w);
+        }
+        const glm::vec3& p = src.position;
+        const glm::vec3& n = src.normal;
+        float32x4_t pos = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(c3, c0, p.x), c1, p.y), c2, p.z);
+        float32x4_t nrm = vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(c0, n.x), c1, n.y), c2, n.z);
+        float len2 = vaddvq_f32(vsetq_lane_f32(0.f, vmulq_f32(nrm, nrm), 3));
+        nrm = vmulq_n_f32(nrm, len2 > 0.f ? 1.f / std::sqrt(len2) : 0.f);
+
+        out[v].position = { vgetq_lane_f32(pos, 0), vgetq_lane_f32(pos, 1), vgetq_lane_f32(pos, 2) };
+        out[v].normal = { vgetq_lane_f32(nrm, 0), vgetq_lane_f32(nrm, 1), vgetq_lane_f32(nrm, 2) };
+#else
+        glm::mat4 m(0.f);
+        for (int k = 0; k < 4; ++k) {
+            float w = src.weights[k] * kInv255;
+            for (int c = 0; c < 4; ++c)
+                m[c] += palette[src.joints[k]][c] * w;
+        }
+        glm::vec4 pos = m * glm::vec4(src.position, 1.f);
+        glm::vec4 nrm = m * glm::vec4(src.normal, 0.f);
+        glm::vec3 n3(nrm.x, nrm.y, nrm.z);
+        float len = glm::length(n3);
+        out[v].position = { pos.x, pos.y, pos.z };
+        out[v].normal = len > 0.f ? n3 / len : n3;
+#endif
+    }
+}
@@ -0,0 +1,48 @@
+// source/anim/Skinning.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/* Vertex layout shared by both skinning paths (32 bytes). */
+struct SkinnedVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    uint8_t joints[4];
+    uint8_t weights[4]; // normalised, sum to 255
+};
+
+/* Output of the CPU path; matches the renderer's pos+normal streams. */
+struct SkinnedOutput {
+    glm::vec3 position;
+    glm::vec3 normal;
+};
+
+enum class SkinningPath {
+    Gpu, // bone palette as a uniform array, skinned in the vertex shader
+    Cpu, // SIMD skinning into a dynamic vertex buffer
+};
+
+// Palette entries the GPU shader declares. 64 mat4 = 256 vec4 uniforms,
+// comfortably inside what the Tegra X1 driver exposes.
+constexpr std::size_t kMaxGpuJoints = 64;
+
+// Rigs this small are cheaper to skin on the CPU than to pay a program
+// switch and palette upload per draw.
+constexpr std::size_t kMaxCpuFastPathJoints = 8;
+
+/*
+ * Rigs over kMaxGpuJoints also go to the CPU: the shader palette cannot
+ * hold them. That is a fallback rather than the fast path, so it costs
+ * CPU time per vertex; draw the result with skinnedDrawCpu().
+ */
+inline SkinningPath chooseSkinningPath(std::size_t jointCount)
+{
+    if (jointCount <= kMaxCpuFastPathJoints || jointCount > kMaxGpuJoints)
+        return SkinningPath::Cpu;
+    return SkinningPath::Gpu;
+}
+
+/* Linear-blend skinning of `count` vertices with the given palette. */
+void skinVertices(const SkinnedVertex* in, std::size_t count,
+    const glm::mat4* palette, SkinnedOutput* out);
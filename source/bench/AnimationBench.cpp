@@ -0,0 +1,114 @@
+#ifdef ENGINE_BENCHMARKS
+#include "Benchmarks.hpp"
+#include "anim/AnimationClip.hpp"
+#include "anim/AnimationSystem.hpp"
+#include "anim/Animator.hpp"
+#include "anim/Skeleton.hpp"
+#include "anim/Skinning.hpp"
+#include "core/GameObject.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Logging.hpp"
+#include "core/Scene.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kJoints = 48;
+constexpr int kCharacters = 256;
+constexpr int kFrames = 100;
+
+// Binary-tree rig: shallow enough to be realistic, wide enough to stress
+// the parent lookups in localToModel.
+Skeleton makeSkeleton()
+{
+    Skeleton s;
+    s.bindPose.resize(kJoints);
+    for (int i = 0; i < kJoints; ++i) {
+        s.names.push_back("joint" + std::to_string(i));
+        s.parents.push_back(int16_t(i == 0 ? -1 : (i - 1) / 2));
+        s.inverseBind.push_back(glm::mat4(1.f));
+        s.bindPose.rotations[i] = glm::quat();
+        s.bindPose.translations[i] = glm::vec3(0.f, 0.1f, 0.f);
+        s.bindPose.scales[i] = glm::vec3(1.f);
+    }
+    return s;
+}
+
+RawClip makeClip(float phase)
+{
+    RawClip raw;
+    raw.frameRate = 30.f;
+    for (int f = 0; f < 60; ++f) {
+        Pose p;
+        p.resize(kJoints);
+        for (int j = 0; j < kJoints; ++j) {
+            float a = std::sin(f * 0.1f + j * 0.3f + phase) * 0.5f;
+            p.rotations[j] = glm::angleAxis(a, glm::normalize(glm::vec3(1.f, 0.3f * j, 0.2f)));
+            p.translations[j] = glm::vec3(0.f, 0.1f, 0.01f * std::sin(f * 0.2f));
+            p.scales[j] = glm::vec3(1.f);
+        }
+        raw.frames.push_back(std::move(p));
+    }
+    return raw;
+}
+
+double timeUpdates(AnimationSystem& system)
+{
+    system.update(1.f / 60.f); // warm caches
+    u64 start = benchNowNs();
+    for (int i = 0; i < kFrames; ++i)
+        system.update(1.f / 60.f);
+    return double(benchNowNs() - start);
+}
+
+} // namespace
+
+void benchAnimation(JobSystem& jobs)
+{
+    Skeleton skeleton = makeSkeleton();
+    AnimationClip walk, run;
+    walk.build(makeClip(0.f));
+    run.build(makeClip(1.f));
+    LOG_INFO("anim: clip %zu bytes (raw %zu)", walk.sizeInBytes(),
+        size_t(60 * kJoints * (sizeof(glm::quat) + 2 * sizeof(glm::vec3))));
+
+    AnimationSystem serial(nullptr);
+    AnimationSystem parallel(&jobs);
+    Scene scene;
+    for (int c = 0; c < kCharacters; ++c) {
+        auto& obj = scene.root().createChild("Character");
+        auto& a = obj.addComponent<Animator>(&obj, c % 2 ? &parallel : &serial, &skeleton);
+        a.play(&walk);
+        a.crossFade(&run, 1000.f); // keep both layers live so blending is measured
+    }
+
+    const double perBone = double(kFrames) * (kCharacters / 2) * kJoints;
+    LOG_INFO("anim: %d chars x %d joints, 2 layers: %.1f ns/bone/char (1 core)",
+        kCharacters / 2, kJoints, timeUpdates(serial) / perBone);
+    LOG_INFO("anim: %d chars x %d joints, 2 layers: %.1f ns/bone/char (%d workers + main)",
+        kCharacters / 2, kJoints, timeUpdates(parallel) / perBone, jobs.workerCount());
+
+    // CPU skinning path
+    constexpr int kVerts = 4096;
+    std::vector<SkinnedVertex> verts(kVerts);
+    for (int v = 0; v < kVerts; ++v) {
+        verts[v].position = glm::vec3(v * 0.001f, 1.f, 0.f);
+        verts[v].normal = glm::vec3(0.f, 1.f, 0.f);
+        for (int k = 0; k < 4; ++k) {
+            verts[v].joints[k] = uint8_t((v + k) % kMaxCpuFastPathJoints);
+            verts[v].weights[k] = k == 0 ? 129 : 42;
+        }
+    }
+    std::vector<SkinnedOutput> out(kVerts);
+    std::vector<glm::mat4> palette(kMaxCpuFastPathJoints, glm::mat4(1.f));
+    u64 start = benchNowNs();
+    for (int i = 0; i < kFrames; ++i)
+        skinVertices(verts.data(), kVerts, palette.data(), out.data());
+    LOG_INFO("anim: cpu skinning %.2f ns/vertex (4 influences)",
+        double(benchNowNs() - start) / (double(kFrames) * kVerts));
+}
+
+#endif // ENGINE_BENCHMARKS
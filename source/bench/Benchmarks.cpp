@@ -0,0 +1,15 @@
+#ifdef ENGINE_BENCHMARKS
+#include "Benchmarks.hpp"
+#include "core/Logging.hpp"
+
+void runBenchmarks(JobSystem& jobs)
+{
+    LOG_INFO("---- benchmarks ----");
+    benchAnimation(jobs);
+    benchParticles(jobs);
+    benchNavigation(jobs);
+    benchRaycast(jobs);
+    LOG_INFO("---- benchmarks done ----");
+}
+
+#endif // ENGINE_BENCHMARKS
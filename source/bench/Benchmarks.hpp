@@ -0,0 +1,18 @@
+#pragma once
+#include <switch.h>
+
+class JobSystem;
+
+/*
+ * On-device micro-benchmarks, compiled in only with
+ *   make DEFINES=-DENGINE_BENCHMARKS
+ * Results are printed through the nxlink log before the main loop starts.
+ */
+void runBenchmarks(JobSystem& jobs);
+
+void benchAnimation(JobSystem& jobs);
+void benchParticles(JobSystem& jobs);
+void benchNavigation(JobSystem& jobs);
+void benchRaycast(JobSystem& jobs);
+
+inline u64 benchNowNs() { return armTicksToNs(armGetSystemTick()); }
@@ -0,0 +1,141 @@
+#ifdef ENGINE_BENCHMARKS
+#include "Benchmarks.hpp"
+#include "core/GameObject.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Logging.hpp"
+#include "core/Scene.hpp"
+#include "core/Transform.hpp"
+#include "geom/StaticMesh.hpp"
+#include "geom/TriMesh.hpp"
+#include "nav/NavAgent.hpp"
+#include "nav/NavMesh.hpp"
+#include "nav/NavMeshBuilder.hpp"
+#include "nav/NavQuery.hpp"
+#include "nav/NavSystem.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr float kLevelSize = 64.f;
+constexpr int kPillars = 120;
+constexpr int kQueries = 1000;
+constexpr int kAgents = 300;
+
+struct Rng {
+    uint32_t s = 0x9E3779B9u;
+    float next01()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return float(s >> 8) * (1.f / 16777216.f);
+    }
+    glm::vec3 point() { return glm::vec3(next01() * kLevelSize, 0.f, next01() * kLevelSize); }
+};
+
+TriMesh makeBox()
+{
+    std::vector<glm::vec3> v;
+    for (int i = 0; i < 8; ++i)
+        v.push_back(glm::vec3(i & 1 ? 0.5f : -0.5f, i & 2 ? 1.f : 0.f, i & 4 ? 0.5f : -0.5f));
+    // outward-facing, counter-clockwise
+    std::vector<uint32_t> idx = { 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2,
+        1, 3, 7, 1, 7, 5, 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6 };
+    TriMesh m;
+    m.setData(std::move(v), std::move(idx));
+    return m;
+}
+
+TriMesh makeFloor()
+{
+    TriMesh m;
+    m.setData({ { 0.f, 0.f, 0.f }, { kLevelSize, 0.f, 0.f }, { kLevelSize, 0.f, kLevelSize },
+                  { 0.f, 0.f, kLevelSize } },
+        { 0, 2, 1, 0, 3, 2 });
+    return m;
+}
+
+} // namespace
+
+void benchNavigation(JobSystem& jobs)
+{
+    // a floor with scattered pillars, placed through Transforms like level art
+    TriMesh floor = makeFloor(), box = makeBox();
+    Scene level;
+    auto& floorObj = level.root().createChild("Floor");
+    floorObj.addComponent<StaticMesh>(&floorObj, &floor);
+    Rng rng;
+    for (int i = 0; i < kPillars; ++i) {
+        auto& obj = level.root().createChild("Pillar");
+        obj.transform().position = rng.point();
+        obj.transform().scale = glm::vec3(1.f + 2.f * rng.next01(), 3.f, 1.f + 2.f * rng.next01());
+        obj.addComponent<StaticMesh>(&obj, &box);
+    }
+
+    NavMeshBuilder builder;
+    builder.addScene(level.root());
+    NavMesh mesh;
+    u64 start = benchNowNs();
+    bool ok = builder.build(mesh);
+    double bakeMs = double(benchNowNs() - start) / 1e6;
+    if (!ok)
+        return;
+    LOG_INFO("nav: baked %zu tris into %zu polys / %zu verts in %.1f ms, %zu bytes on disk",
+        builder.triangleCount(), mesh.polyCount(), mesh.vertices().size(), bakeMs,
+        mesh.serialize().size());
+
+    // single-threaded, whole searches
+    NavQuery query(&mesh);
+    std::vector<uint32_t> corridor;
+    std::vector<glm::vec3> points;
+    const glm::vec3 ext(1.f, 2.f, 1.f);
+    int found = 0;
+    std::size_t corners = 0;
+    start = benchNowNs();
+    for (int i = 0; i < kQueries; ++i) {
+        uint32_t a, b;
+        glm::vec3 pa, pb;
+        if (!query.findNearestPoly(rng.point(), ext, a, pa) || !query.findNearestPoly(rng.point(), ext, b, pb))
+            continue;
+        if (query.findPath(a, b, pa, pb, corridor) == NavStatus::Success)
+            ++found;
+        query.straightPath(corridor, pa, pb, points);
+        corners += points.size();
+    }
+    double us = double(benchNowNs() - start) / 1e3 / kQueries;
+    LOG_INFO("nav: %.1f us/path (%d/%d reached, %.1f corners avg)", us, found, kQueries,
+        double(corners) / kQueries);
+
+    // a crowd re-planning at once: worst frame under the iteration budget
+    NavSystem system(&jobs);
+    system.setNavMesh(&mesh);
+    Scene crowd;
+    std::vector<NavAgent*> agents;
+    std::vector<glm::vec3> goals;
+    for (int i = 0; i < kAgents; ++i) {
+        auto& obj = crowd.root().createChild("Agent");
+        obj.transform().position = rng.point();
+        agents.push_back(&obj.addComponent<NavAgent>(&obj, &system));
+        goals.push_back(rng.point());
+    }
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < kAgents; ++i) {
+            agents[i]->stop();
+            agents[i]->setDestination(goals[i]);
+        }
+        int frames = 0;
+        double worst = 0.0;
+        while (system.pendingCount() > 0 && frames < 1000) {
+            u64 t = benchNowNs();
+            system.update(0.f); // plan only, nobody moves
+            worst = std::max(worst, double(benchNowNs() - t) / 1e6);
+            ++frames;
+        }
+        LOG_INFO("nav: %d agents planned over %d frames, worst %.2f ms (cache %zu hits / %zu misses)",
+            kAgents, frames, worst, system.cacheHits(), system.cacheMisses());
+    }
+}
+
+#endif // ENGINE_BENCHMARKS
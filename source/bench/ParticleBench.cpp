@@ -0,0 +1,64 @@
+#ifdef ENGINE_BENCHMARKS
+#include "Benchmarks.hpp"
+#include "core/GameObject.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Logging.hpp"
+#include "core/Scene.hpp"
+#include "fx/ParticleEmitter.hpp"
+#include "fx/ParticleSystem.hpp"
+
+#include <vector>
+
+namespace {
+
+constexpr int kEmitters = 4;
+constexpr std::size_t kPerEmitter = 32 * 1024;
+constexpr int kFrames = 100;
+
+// Particles simulated per millisecond over kFrames updates.
+double measure(ParticleSystem& system)
+{
+    system.update(1.f / 60.f); // warm caches
+    std::size_t live = system.liveCount();
+    u64 start = benchNowNs();
+    for (int i = 0; i < kFrames; ++i)
+        system.update(1.f / 60.f);
+    double ms = double(benchNowNs() - start) / 1e6;
+    return double(live) * kFrames / ms;
+}
+
+} // namespace
+
+void benchParticles(JobSystem& jobs)
+{
+    EmitterSettings settings;
+    settings.maxParticles = kPerEmitter;
+    settings.rate = 0.f;
+    settings.lifetimeMin = settings.lifetimeMax = 1000.f; // nothing dies mid-run
+    settings.sim.drag = 0.1f;
+
+    ParticleSystem serial(nullptr);
+    ParticleSystem parallel(&jobs);
+    Scene scene;
+    for (int i = 0; i < 2 * kEmitters; ++i) {
+        auto& obj = scene.root().createChild("Emitter");
+        auto& e = obj.addComponent<ParticleEmitter>(&obj, i % 2 ? &parallel : &serial, settings);
+        e.burst(kPerEmitter);
+    }
+
+    LOG_INFO("fx: %zu particles, sim: %.0f particles/ms (1 core)",
+        serial.liveCount(), measure(serial));
+    LOG_INFO("fx: %zu particles, sim: %.0f particles/ms (%d workers + main)",
+        parallel.liveCount(), measure(parallel), jobs.workerCount());
+
+    // instance streaming, written to plain memory instead of a mapped VBO
+    std::vector<ParticleInstance> out(kPerEmitter);
+    const ParticleEmitter* e = parallel.emitters()[0];
+    u64 start = benchNowNs();
+    for (int i = 0; i < kFrames; ++i)
+        e->writeInstances(0, e->pool().size(), out.data());
+    double ms = double(benchNowNs() - start) / 1e6;
+    LOG_INFO("fx: instance fill %.0f particles/ms", double(e->pool().size()) * kFrames / ms);
+}
+
+#endif // ENGINE_BENCHMARKS
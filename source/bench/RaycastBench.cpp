@@ -0,0 +1,214 @@
+#ifdef ENGINE_BENCHMARKS
+#include "Benchmarks.hpp"
+#include "core/GameObject.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Logging.hpp"
+#include "core/Scene.hpp"
+#include "core/Transform.hpp"
+#include "geom/MeshBvh.hpp"
+#include "geom/SceneQuery.hpp"
+#include "geom/StaticMesh.hpp"
+#include "geom/TriMesh.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr int kImage = 256; // camera rays per side
+constexpr int kRandomRays = 64 * 1024;
+constexpr int kOverlaps = 16 * 1024;
+constexpr int kInstances = 64;
+
+struct Rng {
+    uint32_t s = 0x2545F491u;
+    float next01()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return float(s >> 8) * (1.f / 16777216.f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+// rolling hills, two triangles per cell
+TriMesh makeTerrain(int cells, float size)
+{
+    std::vector<glm::vec3> v;
+    std::vector<uint32_t> idx;
+    const float step = size / cells;
+    for (int z = 0; z <= cells; ++z)
+        for (int x = 0; x <= cells; ++x)
+            v.push_back(glm::vec3(x * step, 4.f * std::sin(x * 0.11f) * std::cos(z * 0.07f), z * step));
+    for (int z = 0; z < cells; ++z) {
+        for (int x = 0; x < cells; ++x) {
+            const uint32_t i = uint32_t(z * (cells + 1) + x);
+            const uint32_t row = uint32_t(cells + 1);
+            idx.insert(idx.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+        }
+    }
+    TriMesh m;
+    m.setData(std::move(v), std::move(idx));
+    return m;
+}
+
+// pinhole camera rays over the mesh bounds, row-major pixels
+struct Camera {
+    glm::vec3 eye, forward, right, up;
+
+    explicit Camera(const TriMesh& mesh)
+    {
+        const glm::vec3 center = (mesh.boundsMin() + mesh.boundsMax()) * 0.5f;
+        const float radius = glm::length(mesh.boundsMax() - mesh.boundsMin()) * 0.5f;
+        eye = center + glm::vec3(0.3f, 0.8f, -1.f) * radius * 1.4f;
+        forward = glm::normalize(center - eye);
+        right = glm::normalize(glm::cross(forward, glm::vec3(0.f, 1.f, 0.f)));
+        up = glm::cross(right, forward);
+    }
+    Ray ray(int x, int y) const
+    {
+        const float u = (x + 0.5f) / kImage * 2.f - 1.f;
+        const float v = (y + 0.5f) / kImage * 2.f - 1.f;
+        Ray r;
+        r.origin = eye;
+        r.dir = glm::normalize(forward + right * (u * 0.6f) + up * (v * 0.6f));
+        return r;
+    }
+};
+
+double mraysPerSec(std::size_t rays, u64 ns) { return double(rays) / (double(ns) / 1e3); }
+
+// rows [first, last) as 2x2 pixel packets
+std::size_t tracePackets(const MeshBvh& bvh, const Camera& cam, int first, int last)
+{
+    std::size_t hits = 0;
+    for (int y = first; y < last; y += 2) {
+        for (int x = 0; x < kImage; x += 2) {
+            RayPacket p;
+            for (int i = 0; i < 4; ++i)
+                p.set(i, cam.ray(x + (i & 1), y + (i >> 1)));
+            PacketHit h;
+            unsigned mask = bvh.raycast(p, h);
+            hits += std::size_t(__builtin_popcount(mask));
+        }
+    }
+    return hits;
+}
+
+void benchMesh(const char* name, const TriMesh& mesh, JobSystem& jobs)
+{
+    MeshBvh bvh;
+    u64 start = benchNowNs();
+    bvh.build(mesh.vertices(), mesh.indices());
+    const double buildMs = double(benchNowNs() - start) / 1e6;
+    LOG_INFO("ray: %s: %zu tris, built %zu nodes (%zu KB) in %.2f ms", name, mesh.triangleCount(),
+        bvh.nodeCount(), bvh.memoryUsage() / 1024, buildMs);
+
+    const Camera cam(mesh);
+    const std::size_t pixels = std::size_t(kImage) * kImage;
+
+    std::size_t hits = 0;
+    start = benchNowNs();
+    for (int y = 0; y < kImage; ++y) {
+        for (int x = 0; x < kImage; ++x) {
+            RayHit h;
+            hits += bvh.raycast(cam.ray(x, y), h) ? 1 : 0;
+        }
+    }
+    const u64 singleNs = benchNowNs() - start;
+
+    start = benchNowNs();
+    std::size_t packetHits = tracePackets(bvh, cam, 0, kImage);
+    const u64 packetNs = benchNowNs() - start;
+
+    std::atomic<std::size_t> jobHits { 0 };
+    start = benchNowNs();
+    jobs.parallelFor(kImage / 2, 8, [&](std::size_t b, std::size_t e) {
+        jobHits += tracePackets(bvh, cam, int(b) * 2, int(e) * 2);
+    });
+    const u64 jobNs = benchNowNs() - start;
+
+    LOG_INFO("ray: %s: camera %.2f Mrays/s single, %.2f packet, %.2f packet on %d workers + main (%zu/%zu/%zu hits)",
+        name, mraysPerSec(pixels, singleNs), mraysPerSec(pixels, packetNs), mraysPerSec(pixels, jobNs),
+        jobs.workerCount(), hits, packetHits, jobHits.load());
+
+    // incoherent rays from all around the bounds
+    Rng rng;
+    const glm::vec3 lo = mesh.boundsMin(), hi = mesh.boundsMax();
+    std::vector<Ray> rays(kRandomRays);
+    for (Ray& r : rays) {
+        r.origin = glm::vec3(rng.range(lo.x, hi.x), rng.range(lo.y, hi.y) + (hi.y - lo.y), rng.range(lo.z, hi.z));
+        r.dir = glm::normalize(glm::vec3(rng.range(-1.f, 1.f), rng.range(-1.f, 0.f), rng.range(-1.f, 1.f)));
+    }
+    hits = 0;
+    start = benchNowNs();
+    for (const Ray& r : rays) {
+        RayHit h;
+        hits += bvh.raycast(r, h) ? 1 : 0;
+    }
+    const u64 randomNs = benchNowNs() - start;
+    std::size_t blocked = 0;
+    start = benchNowNs();
+    for (const Ray& r : rays)
+        blocked += bvh.occluded(r) ? 1 : 0;
+    const u64 occludedNs = benchNowNs() - start;
+    LOG_INFO("ray: %s: random %.2f Mrays/s closest hit, %.2f any hit (%zu/%zu hits)", name,
+        mraysPerSec(rays.size(), randomNs), mraysPerSec(rays.size(), occludedNs), hits, blocked);
+
+    // sphere overlaps about a tenth of the mesh across
+    const float radius = glm::length(hi - lo) * 0.05f;
+    std::vector<uint32_t> tris;
+    std::size_t found = 0;
+    start = benchNowNs();
+    for (int i = 0; i < kOverlaps; ++i) {
+        tris.clear();
+        bvh.overlapSphere(glm::vec3(rng.range(lo.x, hi.x), rng.range(lo.y, hi.y), rng.range(lo.z, hi.z)),
+            radius, tris);
+        found += tris.size();
+    }
+    const double overlapUs = double(benchNowNs() - start) / 1e3 / kOverlaps;
+    LOG_INFO("ray: %s: sphere overlap %.2f us/query (%.1f tris avg)", name, overlapUs,
+        double(found) / kOverlaps);
+}
+
+} // namespace
+
+void benchRaycast(JobSystem& jobs)
+{
+    TriMesh sphere;
+    if (sphere.loadFromFile("romfs:/STLs/basic/icosphere.stl"))
+        benchMesh("icosphere", sphere, jobs);
+
+    TriMesh terrain = makeTerrain(256, 128.f);
+    benchMesh("terrain", terrain, jobs);
+
+    if (sphere.triangleCount() == 0)
+        return;
+
+    // ground snapping against scattered, rotated and scaled instances
+    Scene level;
+    Rng rng;
+    for (int i = 0; i < kInstances; ++i) {
+        auto& obj = level.root().createChild("Rock");
+        obj.transform().position = glm::vec3(rng.range(0.f, 64.f), 0.f, rng.range(0.f, 64.f));
+        obj.transform().rotation = glm::angleAxis(rng.range(0.f, 6.28f), glm::vec3(0.f, 1.f, 0.f));
+        obj.transform().scale = glm::vec3(rng.range(1.f, 4.f), rng.range(0.5f, 2.f), rng.range(1.f, 4.f));
+        obj.addComponent<StaticMesh>(&obj, &sphere);
+    }
+    SceneQuery query;
+    query.build(level.root());
+
+    std::size_t hits = 0;
+    u64 start = benchNowNs();
+    for (int i = 0; i < kRandomRays; ++i) {
+        const glm::vec3 from(rng.range(0.f, 64.f), 10.f, rng.range(0.f, 64.f));
+        SceneRayHit h;
+        hits += query.raycast(from, glm::vec3(0.f, -1.f, 0.f), 20.f, h) ? 1 : 0;
+    }
+    LOG_INFO("ray: scene: %zu instances, ground snap %.2f Mrays/s (%zu/%d hits)", query.instanceCount(),
+        mraysPerSec(kRandomRays, benchNowNs() - start), hits, kRandomRays);
+}
+
+#endif // ENGINE_BENCHMARKS
@@ -0,0 +1,109 @@
+#include "JobSystem.hpp"
+#include "Logging.hpp"
+
+namespace {
+constexpr std::size_t kWorkerStackSize = 0x10000;
+constexpr int kWorkerPriority = 0x2C; // same as the main thread
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    mutexInit(&m_mutex);
+    condvarInit(&m_wake);
+    condvarInit(&m_done);
+
+    if (workerCount > kMaxWorkers)
+        workerCount = kMaxWorkers;
+    for (int i = 0; i < workerCount; ++i) {
+        // cores 1 and 2 are free for applications; core 0 runs main()
+        Result rc = threadCreate(&m_threads[i], workerEntry, this, nullptr,
+            kWorkerStackSize, kWorkerPriority, 1 + i % 2);
+        if (R_FAILED(rc)) {
+            LOG_WARN("JobSystem: threadCreate failed (0x%x), %d workers", rc, i);
+            break;
+        }
+        threadStart(&m_threads[i]);
+        ++m_workerCount;
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    mutexLock(&m_mutex);
+    m_quit = true;
+    condvarWakeAll(&m_wake);
+    mutexUnlock(&m_mutex);
+
+    for (int i = 0; i < m_workerCount; ++i) {
+        threadWaitForExit(&m_threads[i]);
+        threadClose(&m_threads[i]);
+    }
+}
+
+void JobSystem::runChunks()
+{
+    for (;;) {
+        std::size_t begin = m_next.fetch_add(m_grain, std::memory_order_relaxed);
+        if (begin >= m_count)
+            return;
+        std::size_t end = begin + m_grain < m_count ? begin + m_grain : m_count;
+        m_fn(m_ctx, begin, end);
+    }
+}
+
+void JobSystem::workerEntry(void* arg)
+{
+    auto* self = static_cast<JobSystem*>(arg);
+    unsigned seen = 0;
+
+    mutexLock(&self->m_mutex);
+    for (;;) {
+        while (!self->m_quit && self->m_generation == seen)
+            condvarWait(&self->m_wake, &self->m_mutex);
+        if (self->m_quit)
+            break;
+        seen = self->m_generation;
+        ++self->m_busyWorkers;
+        mutexUnlock(&self->m_mutex);
+
+        self->runChunks();
+
+        mutexLock(&self->m_mutex);
+        if (--self->m_busyWorkers == 0)
+            condvarWakeAll(&self->m_done);
+    }
+    mutexUnlock(&self->m_mutex);
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, RangeFn fn, void* ctx)
+{
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+    if (m_workerCount == 0 || count <= grain) {
+        fn(ctx, 0, count);
+        return;
+    }
+
+    mutexLock(&m_mutex);
+    // a worker that woke late for the previous job may still be draining it
+    while (m_busyWorkers > 0)
+        condvarWait(&m_done, &m_mutex);
+    m_fn = fn;
+    m_ctx = ctx;
+    m_count = count;
+    m_grain = grain;
+    m_next.store(0, std::memory_order_relaxed);
+    ++m_generation;
+    condvarWakeAll(&m_wake);
+    mutexUnlock(&m_mutex);
+
+    runChunks();
+
+    // wait for workers still inside a chunk; late wakers find nothing left
+    mutexLock(&m_mutex);
+    while (m_busyWorkers > 0)
+        condvarWait(&m_done, &m_mutex);
+    mutexUnlock(&m_mutex);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <switch.h>
+#include <type_traits>
+
+/*
+ * Fixed pool of worker threads pinned to the spare CPU cores (the main
+ * thread keeps core 0). The only primitive is a blocking parallelFor: the
+ * range is cut into chunks that the workers and the calling thread pull
+ * from a shared counter until it is exhausted.
+ *
+ * parallelFor is not re-entrant; call it from one thread at a time.
+ */
+class JobSystem {
+public:
+    using RangeFn = void (*)(void* ctx, std::size_t begin, std::size_t end);
+
+    explicit JobSystem(int workerCount = 2);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int workerCount() const { return m_workerCount; }
+
+    void parallelFor(std::size_t count, std::size_t grain, RangeFn fn, void* ctx);
+
+    // f(begin, end) over [0, count) in chunks of at most `grain` items
+    template <class F>
+    void parallelFor(std::size_t count, std::size_t grain, F&& f)
+    {
+        parallelFor(count, grain, [](void* ctx, std::size_t b, std::size_t e) {
+            (*static_cast<std::remove_reference_t<F>*>(ctx))(b, e);
+        },
+            &f);
+    }
+
+private:
+    static constexpr int kMaxWorkers = 3;
+
+    static void workerEntry(void* arg);
+    void runChunks();
+
+    Thread m_threads[kMaxWorkers] {};
+    int m_workerCount { 0 };
+
+    Mutex m_mutex;
+    CondVar m_wake; // workers: new job or shutdown
+    CondVar m_done; // caller: last worker left the job
+
+    // current job, published under m_mutex by bumping m_generation
+    RangeFn m_fn { nullptr };
+    void* m_ctx { nullptr };
+    std::size_t m_count { 0 };
+    std::size_t m_grain { 1 };
+    unsigned m_generation { 0 };
+    int m_busyWorkers { 0 };
+    bool m_quit { false };
+
+    std::atomic<std::size_t> m_next { 0 };
+};
@@ -1,18 +1,25 @@
 #pragma once
 #include <cstdio>
+#ifdef __SWITCH__
 #include <switch.h>
+#endif
 
+// Without __SWITCH__ (host tools and tests) logging is plain stdout.
 inline void initLogging()
 {
+#ifdef __SWITCH__
     socketInitializeDefault();
     nxlinkStdio();
+#endif
     printf("[INFO] Logging initialized\n");
 }
 
 inline void LoggingExit()
 {
     printf("[INFO] Shutting down logging\n");
+#ifdef __SWITCH__
     socketExit();
+#endif
 }
 
 #define LOG_INFO(fmt, ...)                         \
@@ -0,0 +1,69 @@
+#pragma once
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Small set of hot-loop math kernels. The Switch build uses AArch64 NEON;
+ * other targets fall back to plain glm so the same code stays testable.
+ * glm matrices are column-major, four contiguous floats per column.
+ */
+namespace simd {
+
+/* out = a * b (out may alias neither input) */
+inline void mul(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+{
+#if defined(__ARM_NEON)
+    const float* pa = &a[0][0];
+    const float* pb = &b[0][0];
+    float* po = &out[0][0];
+    float32x4_t a0 = vld1q_f32(pa + 0), a1 = vld1q_f32(pa + 4);
+    float32x4_t a2 = vld1q_f32(pa + 8), a3 = vld1q_f32(pa + 12);
+    for (int c = 0; c < 4; ++c) {
+        float32x4_t bc = vld1q_f32(pb + 4 * c);
+        float32x4_t r = vmulq_laneq_f32(a0, bc, 0);
+        r = vfmaq_laneq_f32(r, a1, bc, 1);
+        r = vfmaq_laneq_f32(r, a2, bc, 2);
+        r = vfmaq_laneq_f32(r, a3, bc, 3);
+        vst1q_f32(po + 4 * c, r);
+    }
+#else
+    out = a * b;
+#endif
+}
+
+/* Matrix from translation, rotation and scale (same as Transform). */
+inline glm::mat4 compose(const glm::vec3& t, const glm::quat& q, const glm::vec3& s)
+{
+    glm::mat4 m = glm::mat4_cast(q);
+    m[0] *= s.x;
+    m[1] *= s.y;
+    m[2] *= s.z;
+    m[3] = glm::vec4(t, 1.f);
+    return m;
+}
+
+/* Normalised lerp along the shortest arc; component order does not matter. */
+inline glm::quat nlerp(const glm::quat& a, const glm::quat& b, float t)
+{
+#if defined(__ARM_NEON)
+    float32x4_t va = vld1q_f32(reinterpret_cast<const float*>(&a));
+    float32x4_t vb = vld1q_f32(reinterpret_cast<const float*>(&b));
+    float d = vaddvq_f32(vmulq_f32(va, vb));
+    float32x4_t r = vmlaq_n_f32(vmulq_n_f32(va, 1.f - t), vb, d < 0.f ? -t : t);
+    float len2 = vaddvq_f32(vmulq_f32(r, r));
+    r = vmulq_n_f32(r, 1.f / std::sqrt(len2));
+    glm::quat out;
+    vst1q_f32(reinterpret_cast<float*>(&out), r);
+    return out;
+#else
+    float sign = glm::dot(a, b) < 0.f ? -1.f : 1.f;
+    return glm::normalize(a * (1.f - t) + b * (t * sign));
+#endif
+}
+
+} // namespace simd
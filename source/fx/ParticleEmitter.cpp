@@ -0,0 +1,106 @@
+// source/fx/ParticleEmitter.cpp
+#include "fx/ParticleEmitter.hpp"
+#include "core/GameObject.hpp"
+#include "core/Transform.hpp"
+#include "fx/ParticleSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+static uint32_t packColor(const glm::vec4& c)
+{
+    auto q = [](float v) { return uint32_t(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f); };
+    return q(c.x) | (q(c.y) << 8) | (q(c.z) << 16) | (q(c.w) << 24);
+}
+
+ParticleEmitter::ParticleEmitter(GameObject* owner, ParticleSystem* system,
+    const EmitterSettings& settings)
+    : Component(owner)
+    , m_system(system)
+    , m_settings(settings)
+    , m_pool(settings.maxParticles)
+    , m_rng(0x9E3779B9u ^ uint32_t(reinterpret_cast<uintptr_t>(this)))
+{
+    m_system->add(this);
+}
+
+ParticleEmitter::~ParticleEmitter()
+{
+    m_system->remove(this);
+}
+
+float ParticleEmitter::random01()
+{
+    // xorshift32: cheap and good enough for visual jitter
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return (m_rng >> 8) * (1.f / 16777216.f);
+}
+
+void ParticleEmitter::update(float dt)
+{
+    if (!m_emitting || m_settings.rate <= 0.f)
+        return;
+    m_accumulator += m_settings.rate * dt;
+    auto whole = std::size_t(m_accumulator);
+    m_accumulator -= float(whole);
+    burst(whole);
+}
+
+void ParticleEmitter::burst(std::size_t count)
+{
+    const std::size_t first = m_pool.size();
+    count = m_pool.spawn(count);
+    if (count == 0)
+        return;
+
+    const Transform& t = owner()->transform();
+    const glm::vec3 origin = t.position;
+    const EmitterSettings& s = m_settings;
+    const float cosSpread = std::cos(s.spread);
+
+    for (std::size_t i = first; i < first + count; ++i) {
+        // uniform direction inside the cone around +Y, then into world space
+        float cz = 1.f - random01() * (1.f - cosSpread);
+        float sz = std::sqrt(std::max(0.f, 1.f - cz * cz));
+        float phi = random01() * glm::two_pi<float>();
+        glm::vec3 dir = t.rotation * glm::vec3(sz * std::cos(phi), cz, sz * std::sin(phi));
+        float speed = s.speedMin + (s.speedMax - s.speedMin) * random01();
+        float life = s.lifetimeMin + (s.lifetimeMax - s.lifetimeMin) * random01();
+
+        m_pool.posX[i] = origin.x;
+        m_pool.posY[i] = origin.y;
+        m_pool.posZ[i] = origin.z;
+        m_pool.velX[i] = dir.x * speed;
+        m_pool.velY[i] = dir.y * speed;
+        m_pool.velZ[i] = dir.z * speed;
+        m_pool.age[i] = 0.f;
+        m_pool.ageRate[i] = life > 0.f ? 1.f / life : 1e6f;
+        m_pool.color[i] = packColor(s.colorA + (s.colorB - s.colorA) * random01());
+    }
+}
+
+void ParticleEmitter::writeInstances(std::size_t begin, std::size_t end,
+    ParticleInstance* out) const
+{
+    const float s0 = m_settings.startSize;
+    const float ds = m_settings.endSize - m_settings.startSize;
+    const bool fade = m_settings.fadeOut;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        float a = std::min(m_pool.age[i], 1.f);
+        uint32_t rgba = m_pool.color[i];
+        if (fade) {
+            uint32_t alpha = uint32_t(float(rgba >> 24) * (1.f - a));
+            rgba = (rgba & 0x00FFFFFFu) | (alpha << 24);
+        }
+        ParticleInstance& p = out[i - begin];
+        p.x = m_pool.posX[i];
+        p.y = m_pool.posY[i];
+        p.z = m_pool.posZ[i];
+        p.size = s0 + ds * a;
+        p.rgba = rgba;
+    }
+}
@@ -0,0 +1,63 @@
+// source/fx/ParticleEmitter.hpp
+#pragma once
+#include "core/Component.hpp"
+#include "fx/ParticlePool.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class ParticleSystem;
+
+struct EmitterSettings {
+    std::size_t maxParticles { 4096 };
+    float rate { 200.f }; // particles per second, 0 for bursts only
+    float lifetimeMin { 1.f }, lifetimeMax { 2.f };
+    float speedMin { 1.f }, speedMax { 3.f };
+    float spread { 0.3f }; // cone half-angle (radians) around local +Y
+    glm::vec4 colorA { 1.f }, colorB { 1.f }; // tint picked between these
+    float startSize { 0.1f }, endSize { 0.f };
+    bool fadeOut { true }; // alpha follows remaining life
+    ParticleSimParams sim;
+};
+
+/* Per-particle record streamed to the GPU each frame (20 bytes). */
+struct ParticleInstance {
+    float x, y, z;
+    float size;
+    uint32_t rgba; // tint with the life fade already applied
+};
+
+/*
+ * Emits particles from the owner's Transform into its own ParticlePool.
+ * Emission runs in the component update; ParticleSystem simulates and
+ * compacts every registered emitter afterwards.
+ */
+class ParticleEmitter : public Component {
+public:
+    ParticleEmitter(GameObject* owner, ParticleSystem* system,
+        const EmitterSettings& settings = {});
+    ~ParticleEmitter() override;
+
+    ComponentTypeID type() const override { return componentTypeID<ParticleEmitter>(); }
+    void update(float dt) override;
+
+    void burst(std::size_t count);
+    void setEmitting(bool on) { m_emitting = on; }
+
+    /* Fills out[0 .. end-begin) from live particles [begin, end). */
+    void writeInstances(std::size_t begin, std::size_t end, ParticleInstance* out) const;
+
+    EmitterSettings& settings() { return m_settings; }
+    const EmitterSettings& settings() const { return m_settings; }
+    ParticlePool& pool() { return m_pool; }
+    const ParticlePool& pool() const { return m_pool; }
+
+private:
+    float random01();
+
+    ParticleSystem* m_system;
+    EmitterSettings m_settings;
+    ParticlePool m_pool;
+    float m_accumulator { 0.f };
+    uint32_t m_rng;
+    bool m_emitting { true };
+};
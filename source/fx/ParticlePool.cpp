@@ -0,0 +1,98 @@
+// source/fx/ParticlePool.cpp
+#include "fx/ParticlePool.hpp"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+ParticlePool::ParticlePool(std::size_t capacity)
+    : posX(capacity)
+    , posY(capacity)
+    , posZ(capacity)
+    , velX(capacity)
+    , velY(capacity)
+    , velZ(capacity)
+    , age(capacity)
+    , ageRate(capacity)
+    , color(capacity)
+{
+}
+
+std::size_t ParticlePool::spawn(std::size_t n)
+{
+    std::size_t room = capacity() - m_count;
+    if (n > room)
+        n = room;
+    m_count += n;
+    return n;
+}
+
+void ParticlePool::simulate(std::size_t begin, std::size_t end, float dt,
+    const ParticleSimParams& params)
+{
+    const float damp = params.drag * dt < 1.f ? 1.f - params.drag * dt : 0.f;
+    const float gx = params.gravity.x * dt;
+    const float gy = params.gravity.y * dt;
+    const float gz = params.gravity.z * dt;
+
+    float* px = posX.data();
+    float* py = posY.data();
+    float* pz = posZ.data();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* vz = velZ.data();
+    float* a = age.data();
+    const float* rate = ageRate.data();
+
+    std::size_t i = begin;
+#if defined(__ARM_NEON)
+    const float32x4_t vdamp = vdupq_n_f32(damp);
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    const float32x4_t vgx = vdupq_n_f32(gx);
+    const float32x4_t vgy = vdupq_n_f32(gy);
+    const float32x4_t vgz = vdupq_n_f32(gz);
+    for (; i + 4 <= end; i += 4) {
+        // v = (v + g*dt) * damp ; p += v*dt ; age += rate*dt
+        float32x4_t x = vmulq_f32(vaddq_f32(vld1q_f32(vx + i), vgx), vdamp);
+        float32x4_t y = vmulq_f32(vaddq_f32(vld1q_f32(vy + i), vgy), vdamp);
+        float32x4_t z = vmulq_f32(vaddq_f32(vld1q_f32(vz + i), vgz), vdamp);
+        vst1q_f32(vx + i, x);
+        vst1q_f32(vy + i, y);
+        vst1q_f32(vz + i, z);
+        vst1q_f32(px + i, vfmaq_f32(vld1q_f32(px + i), x, vdt));
+        vst1q_f32(py + i, vfmaq_f32(vld1q_f32(py + i), y, vdt));
+        vst1q_f32(pz + i, vfmaq_f32(vld1q_f32(pz + i), z, vdt));
+        vst1q_f32(a + i, vfmaq_f32(vld1q_f32(a + i), vld1q_f32(rate + i), vdt));
+    }
+#endif
+    for (; i < end; ++i) {
+        vx[i] = (vx[i] + gx) * damp;
+        vy[i] = (vy[i] + gy) * damp;
+        vz[i] = (vz[i] + gz) * damp;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        pz[i] += vz[i] * dt;
+        a[i] += rate[i] * dt;
+    }
+}
+
+void ParticlePool::compact()
+{
+    std::size_t i = 0;
+    while (i < m_count) {
+        if (age[i] < 1.f) {
+            ++i;
+            continue;
+        }
+        std::size_t last = --m_count;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        posZ[i] = posZ[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        velZ[i] = velZ[last];
+        age[i] = age[last];
+        ageRate[i] = ageRate[last];
+        color[i] = color[last];
+    }
+}
@@ -0,0 +1,48 @@
+// source/fx/ParticlePool.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+/* Per-emitter simulation constants, applied to every live particle. */
+struct ParticleSimParams {
+    glm::vec3 gravity { 0.f, -9.81f, 0.f };
+    float drag { 0.f }; // fraction of velocity lost per second
+};
+
+/*
+ * Structure-of-arrays particle storage with a fixed capacity. Live
+ * particles are always packed into [0, size()); dead ones are removed by
+ * swapping the last live particle into their slot, so order is not
+ * stable but no holes are ever simulated or drawn.
+ *
+ * Age is normalised: `age` runs from 0 to 1 at `ageRate` per second, so
+ * dying is a single compare and fades need no division.
+ */
+struct ParticlePool {
+    explicit ParticlePool(std::size_t capacity = 0);
+
+    std::size_t size() const { return m_count; }
+    std::size_t capacity() const { return posX.size(); }
+
+    /* Reserves up to n new particles; returns how many fit. The new
+       slots start at the old size() and must be filled by the caller. */
+    std::size_t spawn(std::size_t n);
+
+    /* Forces, integration and ageing for [begin, end); thread-safe for
+       disjoint ranges. */
+    void simulate(std::size_t begin, std::size_t end, float dt,
+        const ParticleSimParams& params);
+
+    /* Swap-removes every particle whose age reached 1. */
+    void compact();
+
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> age, ageRate;
+    std::vector<uint32_t> color; // RGBA8, tint picked at spawn
+
+private:
+    std::size_t m_count { 0 };
+};
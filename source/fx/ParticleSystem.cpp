@@ -0,0 +1,63 @@
+// source/fx/ParticleSystem.cpp
+#include "fx/ParticleSystem.hpp"
+#include "core/JobSystem.hpp"
+#include "fx/ParticleEmitter.hpp"
+
+#include <algorithm>
+
+ParticleSystem::ParticleSystem(JobSystem* jobs)
+    : m_jobs(jobs)
+{
+}
+
+void ParticleSystem::add(ParticleEmitter* emitter)
+{
+    m_emitters.push_back(emitter);
+}
+
+void ParticleSystem::remove(ParticleEmitter* emitter)
+{
+    auto it = std::find(m_emitters.begin(), m_emitters.end(), emitter);
+    if (it != m_emitters.end()) {
+        *it = m_emitters.back();
+        m_emitters.pop_back();
+    }
+}
+
+std::size_t ParticleSystem::liveCount() const
+{
+    std::size_t n = 0;
+    for (const ParticleEmitter* e : m_emitters)
+        n += e->pool().size();
+    return n;
+}
+
+void ParticleSystem::update(float dt)
+{
+    m_chunks.clear();
+    for (ParticleEmitter* e : m_emitters) {
+        const std::size_t n = e->pool().size();
+        for (std::size_t b = 0; b < n; b += kChunkSize)
+            m_chunks.push_back({ e, uint32_t(b), uint32_t(std::min(n, b + kChunkSize)) });
+    }
+
+    auto simulate = [this, dt](std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; ++c) {
+            const Chunk& ch = m_chunks[c];
+            ch.emitter->pool().simulate(ch.begin, ch.end, dt, ch.emitter->settings().sim);
+        }
+    };
+    // pools are independent, so compaction parallelises per emitter
+    auto compact = [this](std::size_t first, std::size_t last) {
+        for (std::size_t e = first; e < last; ++e)
+            m_emitters[e]->pool().compact();
+    };
+
+    if (m_jobs) {
+        m_jobs->parallelFor(m_chunks.size(), 1, simulate);
+        m_jobs->parallelFor(m_emitters.size(), 1, compact);
+    } else {
+        simulate(0, m_chunks.size());
+        compact(0, m_emitters.size());
+    }
+}
@@ -0,0 +1,41 @@
+// source/fx/ParticleSystem.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+class ParticleEmitter;
+
+/*
+ * Simulates every registered ParticleEmitter once per frame. Each pool is
+ * cut into fixed-size chunks and all chunks of all emitters are handed to
+ * the JobSystem as one flat range, so a single huge effect spreads across
+ * cores as well as many small ones. Compaction follows per emitter.
+ */
+class ParticleSystem {
+public:
+    explicit ParticleSystem(JobSystem* jobs = nullptr);
+
+    void add(ParticleEmitter* emitter);
+    void remove(ParticleEmitter* emitter);
+
+    void update(float dt);
+
+    const std::vector<ParticleEmitter*>& emitters() const { return m_emitters; }
+    std::size_t liveCount() const;
+    JobSystem* jobs() const { return m_jobs; }
+
+    // particles per job; a multiple of the SIMD width
+    static constexpr std::size_t kChunkSize = 2048;
+
+private:
+    struct Chunk {
+        ParticleEmitter* emitter;
+        uint32_t begin, end;
+    };
+
+    JobSystem* m_jobs;
+    std::vector<ParticleEmitter*> m_emitters;
+    std::vector<Chunk> m_chunks; // rebuilt every update, capacity kept
+};
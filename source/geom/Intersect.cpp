@@ -0,0 +1,110 @@
+// source/geom/Intersect.cpp
+#include "geom/Intersect.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace geom {
+
+// Ericson, Real-Time Collision Detection 5.1.5: walk the Voronoi regions
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b,
+    const glm::vec3& c)
+{
+    const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.f && d2 <= 0.f)
+        return a;
+
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.f && d4 <= d3)
+        return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+        return a + ab * (d1 / (d1 - d3));
+
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.f && d5 <= d6)
+        return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+        return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    const float denom = va + vb + vc;
+    if (denom == 0.f) // degenerate triangle, every region test was inconclusive
+        return a;
+    const float v = vb / denom, w = vc / denom;
+    return a + ab * v + ac * w;
+}
+
+bool triangleOverlapsSphere(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    const glm::vec3& center, float radius)
+{
+    const glm::vec3 d = closestPointOnTriangle(center, a, b, c) - center;
+    return glm::dot(d, d) <= radius * radius;
+}
+
+// Akenine-Moller: box face normals, triangle normal, then the nine edge cross products
+bool triangleOverlapsBox(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+    const glm::vec3 center = (boxMin + boxMax) * 0.5f;
+    const glm::vec3 h = (boxMax - boxMin) * 0.5f;
+    const glm::vec3 v0 = a - center, v1 = b - center, v2 = c - center;
+
+    for (int i = 0; i < 3; ++i) {
+        const float lo = std::min({ v0[i], v1[i], v2[i] });
+        const float hi = std::max({ v0[i], v1[i], v2[i] });
+        if (lo > h[i] || hi < -h[i])
+            return false;
+    }
+
+    const glm::vec3 e[3] = { v1 - v0, v2 - v1, v0 - v2 };
+    const glm::vec3 n = glm::cross(e[0], e[1]);
+    const float r = h.x * std::fabs(n.x) + h.y * std::fabs(n.y) + h.z * std::fabs(n.z);
+    if (std::fabs(glm::dot(n, v0)) > r)
+        return false;
+
+    for (int i = 0; i < 3; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            // axis = unit(k) x e[i]
+            glm::vec3 axis(0.f);
+            axis[(k + 1) % 3] = -e[i][(k + 2) % 3];
+            axis[(k + 2) % 3] = e[i][(k + 1) % 3];
+            const float p0 = glm::dot(axis, v0), p1 = glm::dot(axis, v1), p2 = glm::dot(axis, v2);
+            const float rad = h.x * std::fabs(axis.x) + h.y * std::fabs(axis.y) + h.z * std::fabs(axis.z);
+            if (std::min({ p0, p1, p2 }) > rad || std::max({ p0, p1, p2 }) < -rad)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool rayOverlapsBox(const glm::vec3& origin, const glm::vec3& invDir, float tMax,
+    const glm::vec3& boxMin, const glm::vec3& boxMax, float& tNear, float& tFar)
+{
+    const glm::vec3 t0 = (boxMin - origin) * invDir;
+    const glm::vec3 t1 = (boxMax - origin) * invDir;
+    const glm::vec3 lo = glm::min(t0, t1), hi = glm::max(t0, t1);
+    tNear = std::max(std::max(lo.x, lo.y), std::max(lo.z, 0.f));
+    tFar = std::min(std::min(hi.x, hi.y), std::min(hi.z, tMax));
+    return tNear <= tFar;
+}
+
+glm::vec3 safeInverse(const glm::vec3& dir)
+{
+    constexpr float kTiny = 1e-20f;
+    glm::vec3 inv;
+    for (int i = 0; i < 3; ++i)
+        inv[i] = 1.f / (std::fabs(dir[i]) > kTiny ? dir[i] : std::copysign(kTiny, dir[i]));
+    return inv;
+}
+
+} // namespace geom
@@ -0,0 +1,29 @@
+// source/geom/Intersect.hpp
+#pragma once
+#include <glm/glm.hpp>
+
+/*
+ * Exact primitive tests shared by the BVH leaves and the scene queries.
+ * Scalar on purpose: they only run on the few triangles that survive the
+ * bounding-volume culling.
+ */
+namespace geom {
+
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b,
+    const glm::vec3& c);
+
+bool triangleOverlapsSphere(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    const glm::vec3& center, float radius);
+
+/* Separating-axis test against an axis-aligned box. */
+bool triangleOverlapsBox(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+/* Slab test; on a hit tNear/tFar are clipped to [0, tMax]. */
+bool rayOverlapsBox(const glm::vec3& origin, const glm::vec3& invDir, float tMax,
+    const glm::vec3& boxMin, const glm::vec3& boxMax, float& tNear, float& tFar);
+
+/* Reciprocal that never produces inf/NaN in a slab test (zero components become huge). */
+glm::vec3 safeInverse(const glm::vec3& dir);
+
+} // namespace geom
@@ -0,0 +1,732 @@
+// source/geom/MeshBvh.cpp
+#include "geom/MeshBvh.hpp"
+#include "geom/Intersect.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* ------------------------------ 4-lane math ----------------------------- */
+// Just enough of a float4 to write the traversal once. NEON on the Switch,
+// the compiler's generic vectors elsewhere so the code stays testable.
+// Arithmetic uses the built-in vector operators (GCC accepts them on NEON
+// types too); comparisons and masks go through named helpers.
+namespace {
+
+#if defined(__ARM_NEON)
+using f4 = float32x4_t;
+using m4 = uint32x4_t;
+
+inline f4 load(const float* p) { return vld1q_f32(p); }
+inline f4 splat(float x) { return vdupq_n_f32(x); }
+inline void store(float* p, f4 a) { vst1q_f32(p, a); }
+inline f4 vmin(f4 a, f4 b) { return vminq_f32(a, b); }
+inline f4 vmax(f4 a, f4 b) { return vmaxq_f32(a, b); }
+inline f4 vabs(f4 a) { return vabsq_f32(a); }
+inline m4 lt(f4 a, f4 b) { return vcltq_f32(a, b); }
+inline m4 le(f4 a, f4 b) { return vcleq_f32(a, b); }
+inline m4 gt(f4 a, f4 b) { return vcgtq_f32(a, b); }
+inline m4 ge(f4 a, f4 b) { return vcgeq_f32(a, b); }
+inline m4 both(m4 a, m4 b) { return vandq_u32(a, b); }
+inline f4 select(m4 m, f4 a, f4 b) { return vbslq_f32(m, a, b); }
+inline unsigned bits(m4 m)
+{
+    static const int32_t shifts[4] = { 0, 1, 2, 3 };
+    return vaddvq_u32(vshlq_u32(vshrq_n_u32(m, 31), vld1q_s32(shifts)));
+}
+#else
+// generic vectors: SSE on an x86 host, scalar code anywhere else
+typedef float f4 __attribute__((vector_size(16)));
+typedef int32_t m4 __attribute__((vector_size(16)));
+
+inline f4 load(const float* p)
+{
+    f4 r;
+    std::memcpy(&r, p, sizeof(r));
+    return r;
+}
+inline f4 splat(float x) { return f4 { x, x, x, x }; }
+inline void store(float* p, f4 a) { std::memcpy(p, &a, sizeof(a)); }
+inline f4 vmin(f4 a, f4 b) { return a < b ? a : b; }
+inline f4 vmax(f4 a, f4 b) { return a > b ? a : b; }
+inline f4 vabs(f4 a) { return a < splat(0.f) ? -a : a; }
+inline m4 lt(f4 a, f4 b) { return a < b; }
+inline m4 le(f4 a, f4 b) { return a <= b; }
+inline m4 gt(f4 a, f4 b) { return a > b; }
+inline m4 ge(f4 a, f4 b) { return a >= b; }
+inline m4 both(m4 a, m4 b) { return a & b; }
+inline f4 select(m4 m, f4 a, f4 b) { return m ? a : b; }
+inline unsigned bits(m4 m)
+{
+    return unsigned(m[0] & 1) | unsigned(m[1] & 1) << 1 | unsigned(m[2] & 1) << 2 | unsigned(m[3] & 1) << 3;
+}
+#endif
+
+inline float lane(f4 a, int i)
+{
+    alignas(16) float tmp[4];
+    store(tmp, a);
+    return tmp[i];
+}
+
+inline int lowestBit(unsigned mask) { return __builtin_ctz(mask); }
+
+constexpr float kDetEpsilon = 1e-30f;
+constexpr int kBins = 12;
+constexpr uint32_t kMaxLeafTris = 4; // one SoA block
+constexpr int kMaxSahDepth = 48; // past this, split at the median to bound the stack depth
+constexpr int kStackSize = 256;
+
+/* Ray splatted across all lanes, for single-ray traversal. */
+struct RayLanes {
+    f4 ox, oy, oz, dx, dy, dz, ix, iy, iz;
+
+    explicit RayLanes(const Ray& ray)
+    {
+        const glm::vec3 inv = geom::safeInverse(ray.dir);
+        ox = splat(ray.origin.x), oy = splat(ray.origin.y), oz = splat(ray.origin.z);
+        dx = splat(ray.dir.x), dy = splat(ray.dir.y), dz = splat(ray.dir.z);
+        ix = splat(inv.x), iy = splat(inv.y), iz = splat(inv.z);
+    }
+};
+
+/* Four rays, one per lane. */
+struct PacketLanes {
+    f4 ox, oy, oz, dx, dy, dz, ix, iy, iz;
+
+    explicit PacketLanes(const RayPacket& rays)
+    {
+        ox = load(rays.ox), oy = load(rays.oy), oz = load(rays.oz);
+        dx = load(rays.dx), dy = load(rays.dy), dz = load(rays.dz);
+        alignas(16) float inv[3][4];
+        for (int i = 0; i < 4; ++i) {
+            const glm::vec3 r = geom::safeInverse(glm::vec3(rays.dx[i], rays.dy[i], rays.dz[i]));
+            inv[0][i] = r.x, inv[1][i] = r.y, inv[2][i] = r.z;
+        }
+        ix = load(inv[0]), iy = load(inv[1]), iz = load(inv[2]);
+    }
+};
+
+/* Slab test of one or four rays against one or four boxes; returns tNear, sets `hit`. */
+inline f4 slab(f4 ox, f4 oy, f4 oz, f4 ix, f4 iy, f4 iz, f4 minX, f4 minY, f4 minZ, f4 maxX,
+    f4 maxY, f4 maxZ, f4 tMax, m4& hit)
+{
+    const f4 ax = (minX - ox) * ix, bx = (maxX - ox) * ix;
+    const f4 ay = (minY - oy) * iy, by = (maxY - oy) * iy;
+    const f4 az = (minZ - oz) * iz, bz = (maxZ - oz) * iz;
+    const f4 tNear = vmax(vmax(vmin(ax, bx), vmin(ay, by)), vmax(vmin(az, bz), splat(0.f)));
+    const f4 tFar = vmin(vmin(vmax(ax, bx), vmax(ay, by)), vmin(vmax(az, bz), tMax));
+    hit = le(tNear, tFar);
+    return tNear;
+}
+
+/* Moller-Trumbore, double sided, lane by lane; returns t, sets u, v and `hit` for t in (0, tMax). */
+inline f4 intersect(f4 ox, f4 oy, f4 oz, f4 dx, f4 dy, f4 dz, f4 v0x, f4 v0y, f4 v0z, f4 e1x,
+    f4 e1y, f4 e1z, f4 e2x, f4 e2y, f4 e2z, f4 tMax, f4& u, f4& v, m4& hit)
+{
+    const f4 px = dy * e2z - dz * e2y;
+    const f4 py = dz * e2x - dx * e2z;
+    const f4 pz = dx * e2y - dy * e2x;
+    const f4 det = e1x * px + e1y * py + e1z * pz;
+    const m4 valid = gt(vabs(det), splat(kDetEpsilon)); // also rejects padding lanes
+    const f4 inv = splat(1.f) / select(valid, det, splat(1.f));
+
+    const f4 tx = ox - v0x, ty = oy - v0y, tz = oz - v0z;
+    u = (tx * px + ty * py + tz * pz) * inv;
+    const f4 qx = ty * e1z - tz * e1y;
+    const f4 qy = tz * e1x - tx * e1z;
+    const f4 qz = tx * e1y - ty * e1x;
+    v = (dx * qx + dy * qy + dz * qz) * inv;
+    const f4 t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+
+    const f4 zero = splat(0.f);
+    hit = both(both(valid, both(ge(u, zero), ge(v, zero))),
+        both(le(u + v, splat(1.f)), both(gt(t, zero), lt(t, tMax))));
+    return t;
+}
+
+struct StackEntry {
+    uint32_t child;
+    float tNear;
+};
+
+/* Pushes the masked children of a node far-to-near so the nearest pops first. */
+inline void pushSorted(StackEntry* stack, int& sp, const uint32_t* child, const float* tNear,
+    unsigned mask)
+{
+    StackEntry hits[4];
+    int n = 0;
+    while (mask) {
+        const int i = lowestBit(mask);
+        mask &= mask - 1;
+        int k = n++;
+        for (; k > 0 && hits[k - 1].tNear < tNear[i]; --k)
+            hits[k] = hits[k - 1];
+        hits[k] = { child[i], tNear[i] };
+    }
+    for (int i = 0; i < n && sp < kStackSize; ++i)
+        stack[sp++] = hits[i];
+}
+
+} // namespace
+
+/* -------------------------------- build --------------------------------- */
+struct MeshBvh::BuildTri {
+    glm::vec3 corner[3];
+    glm::vec3 bmin, bmax, centroid;
+    uint32_t index;
+};
+
+struct MeshBvh::BuildNode {
+    glm::vec3 bmin, bmax;
+    uint32_t left { 0 }, right { 0 }; // children in the build tree (interior)
+    uint32_t first { 0 }, count { 0 }; // range in the order array (leaf when count > 0)
+};
+
+namespace {
+
+float halfArea(const glm::vec3& bmin, const glm::vec3& bmax)
+{
+    const glm::vec3 e = glm::max(bmax - bmin, glm::vec3(0.f));
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+} // namespace
+
+void RayPacket::set(int lane, const Ray& ray)
+{
+    ox[lane] = ray.origin.x, oy[lane] = ray.origin.y, oz[lane] = ray.origin.z;
+    dx[lane] = ray.dir.x, dy[lane] = ray.dir.y, dz[lane] = ray.dir.z;
+    tMax[lane] = ray.tMax;
+}
+
+void MeshBvh::clear()
+{
+    m_nodes.clear();
+    m_blocks.clear();
+    m_blockTris.clear();
+}
+
+std::size_t MeshBvh::memoryUsage() const
+{
+    return m_nodes.size() * sizeof(Node) + m_blocks.size() * sizeof(TriBlock)
+        + m_blockTris.size() * sizeof(uint32_t);
+}
+
+void MeshBvh::build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices)
+{
+    clear();
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount == 0)
+        return;
+
+    std::vector<BuildTri> tris(triCount);
+    for (std::size_t i = 0; i < triCount; ++i) {
+        BuildTri& t = tris[i];
+        for (int k = 0; k < 3; ++k)
+            t.corner[k] = vertices[indices[i * 3 + k]];
+        t.bmin = glm::min(glm::min(t.corner[0], t.corner[1]), t.corner[2]);
+        t.bmax = glm::max(glm::max(t.corner[0], t.corner[1]), t.corner[2]);
+        t.centroid = (t.bmin + t.bmax) * 0.5f;
+        t.index = uint32_t(i);
+    }
+    std::vector<uint32_t> order(triCount);
+    for (std::size_t i = 0; i < triCount; ++i)
+        order[i] = uint32_t(i);
+
+    // binary tree first: binned SAH, top-down with an explicit stack
+    std::vector<BuildNode> tree;
+    tree.reserve(triCount / 2 + 1);
+    tree.push_back({});
+    tree[0].count = uint32_t(triCount);
+
+    struct Todo {
+        uint32_t node;
+        int depth;
+    };
+    std::vector<Todo> todo = { { 0, 0 } };
+    while (!todo.empty()) {
+        const Todo job = todo.back();
+        todo.pop_back();
+        const uint32_t first = tree[job.node].first, count = tree[job.node].count;
+
+        glm::vec3 bmin = tris[order[first]].bmin, bmax = tris[order[first]].bmax;
+        glm::vec3 cmin = tris[order[first]].centroid, cmax = cmin;
+        for (uint32_t i = first; i < first + count; ++i) {
+            const BuildTri& t = tris[order[i]];
+            bmin = glm::min(bmin, t.bmin);
+            bmax = glm::max(bmax, t.bmax);
+            cmin = glm::min(cmin, t.centroid);
+            cmax = glm::max(cmax, t.centroid);
+        }
+        tree[job.node].bmin = bmin;
+        tree[job.node].bmax = bmax;
+
+        // a leaf block tests four triangles for the price of one, so never split below that
+        if (count <= kMaxLeafTris)
+            continue;
+
+        const glm::vec3 extent = cmax - cmin;
+        uint32_t mid = first + count / 2;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+        if (extent[axis] > 0.f && job.depth < kMaxSahDepth) {
+            struct Bin {
+                glm::vec3 bmin { 1e30f }, bmax { -1e30f };
+                uint32_t count { 0 };
+            };
+            float bestCost = 1e30f;
+            int bestAxis = -1, bestSplit = 0;
+            for (int a = 0; a < 3; ++a) {
+                if (extent[a] <= 0.f)
+                    continue;
+                Bin bins[kBins];
+                const float scale = kBins / extent[a];
+                for (uint32_t i = first; i < first + count; ++i) {
+                    const BuildTri& t = tris[order[i]];
+                    const int b = std::min(kBins - 1, int((t.centroid[a] - cmin[a]) * scale));
+                    bins[b].bmin = glm::min(bins[b].bmin, t.bmin);
+                    bins[b].bmax = glm::max(bins[b].bmax, t.bmax);
+                    ++bins[b].count;
+                }
+                // sweep from the right, then evaluate each plane from the left
+                float rightCost[kBins];
+                glm::vec3 rmin(1e30f), rmax(-1e30f);
+                uint32_t rcount = 0;
+                for (int b = kBins - 1; b > 0; --b) {
+                    rmin = glm::min(rmin, bins[b].bmin);
+                    rmax = glm::max(rmax, bins[b].bmax);
+                    rcount += bins[b].count;
+                    rightCost[b] = rcount ? halfArea(rmin, rmax) * float(rcount) : 0.f;
+                }
+                glm::vec3 lmin(1e30f), lmax(-1e30f);
+                uint32_t lcount = 0;
+                for (int b = 0; b < kBins - 1; ++b) {
+                    lmin = glm::min(lmin, bins[b].bmin);
+                    lmax = glm::max(lmax, bins[b].bmax);
+                    lcount += bins[b].count;
+                    if (lcount == 0 || lcount == count)
+                        continue;
+                    const float cost = halfArea(lmin, lmax) * float(lcount) + rightCost[b + 1];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = a;
+                        bestSplit = b;
+                    }
+                }
+            }
+            if (bestAxis >= 0) {
+                const float scale = kBins / extent[bestAxis];
+                const float lo = cmin[bestAxis];
+                auto it = std::partition(order.begin() + first, order.begin() + first + count,
+                    [&](uint32_t t) {
+                        return std::min(kBins - 1, int((tris[t].centroid[bestAxis] - lo) * scale)) <= bestSplit;
+                    });
+                mid = uint32_t(it - order.begin());
+                axis = -1;
+            }
+        }
+        if (axis >= 0) {
+            // flat centroid spread or too deep: object median keeps it balanced
+            std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                [&](uint32_t a, uint32_t b) { return tris[a].centroid[axis] < tris[b].centroid[axis]; });
+        }
+
+        const uint32_t left = uint32_t(tree.size());
+        tree.push_back({});
+        tree.push_back({});
+        tree[left].first = first;
+        tree[left].count = mid - first;
+        tree[left + 1].first = mid;
+        tree[left + 1].count = first + count - mid;
+        tree[job.node].left = left;
+        tree[job.node].right = left + 1;
+        tree[job.node].count = 0;
+        todo.push_back({ left + 1, job.depth + 1 });
+        todo.push_back({ left, job.depth + 1 });
+    }
+
+    // collapse into 4-wide nodes; a lone leaf still gets a root node
+    m_nodes.reserve(tree.size() / 3 + 1);
+    m_blocks.reserve(triCount / 2 + 1);
+    if (tree[0].count > 0) {
+        m_nodes.emplace_back();
+        Node& root = m_nodes[0];
+        std::memset(&root, 0, sizeof(root));
+        root.minX[0] = tree[0].bmin.x, root.minY[0] = tree[0].bmin.y, root.minZ[0] = tree[0].bmin.z;
+        root.maxX[0] = tree[0].bmax.x, root.maxY[0] = tree[0].bmax.y, root.maxZ[0] = tree[0].bmax.z;
+        root.child[0] = kLeaf | emitLeaf(tree[0], tris, order);
+        root.child[1] = root.child[2] = root.child[3] = kEmptySlot;
+    } else {
+        flatten(tree, 0, tris, order);
+    }
+}
+
+uint32_t MeshBvh::emitLeaf(const BuildNode& leaf, const std::vector<BuildTri>& tris,
+    const std::vector<uint32_t>& order)
+{
+    const uint32_t b = uint32_t(m_blocks.size());
+    TriBlock& block = m_blocks.emplace_back();
+    std::memset(&block, 0, sizeof(block));
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+        if (lane >= leaf.count) {
+            m_blockTris.push_back(kNoTriangle); // zero edges: never hit
+            continue;
+        }
+        const BuildTri& t = tris[order[leaf.first + lane]];
+        const glm::vec3 e1 = t.corner[1] - t.corner[0], e2 = t.corner[2] - t.corner[0];
+        block.v0x[lane] = t.corner[0].x, block.v0y[lane] = t.corner[0].y, block.v0z[lane] = t.corner[0].z;
+        block.e1x[lane] = e1.x, block.e1y[lane] = e1.y, block.e1z[lane] = e1.z;
+        block.e2x[lane] = e2.x, block.e2y[lane] = e2.y, block.e2z[lane] = e2.z;
+        m_blockTris.push_back(t.index);
+    }
+    return b;
+}
+
+uint32_t MeshBvh::flatten(const std::vector<BuildNode>& tree, uint32_t root,
+    const std::vector<BuildTri>& tris, const std::vector<uint32_t>& order)
+{
+    // open the largest interior child until there are four
+    uint32_t kids[4] = { tree[root].left, tree[root].right };
+    int n = 2;
+    while (n < 4) {
+        int best = -1;
+        float bestArea = -1.f;
+        for (int i = 0; i < n; ++i) {
+            const BuildNode& c = tree[kids[i]];
+            const float a = halfArea(c.bmin, c.bmax);
+            if (c.count == 0 && a > bestArea) {
+                bestArea = a;
+                best = i;
+            }
+        }
+        if (best < 0)
+            break;
+        const uint32_t opened = kids[best];
+        kids[best] = tree[opened].left;
+        kids[n++] = tree[opened].right;
+    }
+
+    const uint32_t index = uint32_t(m_nodes.size());
+    m_nodes.emplace_back();
+    std::memset(&m_nodes[index], 0, sizeof(Node));
+    for (int i = 0; i < 4; ++i) {
+        if (i >= n) {
+            m_nodes[index].child[i] = kEmptySlot;
+            continue;
+        }
+        const BuildNode& c = tree[kids[i]];
+        // recursion may grow m_nodes, so no reference held across it
+        const uint32_t child = c.count > 0 ? kLeaf | emitLeaf(c, tris, order) : flatten(tree, kids[i], tris, order);
+        Node& node = m_nodes[index];
+        node.minX[i] = c.bmin.x, node.minY[i] = c.bmin.y, node.minZ[i] = c.bmin.z;
+        node.maxX[i] = c.bmax.x, node.maxY[i] = c.bmax.y, node.maxZ[i] = c.bmax.z;
+        node.child[i] = child;
+    }
+    return index;
+}
+
+/* ------------------------------- queries -------------------------------- */
+bool MeshBvh::raycast(const Ray& ray, RayHit& hit) const
+{
+    if (m_nodes.empty())
+        return false;
+    const RayLanes r(ray);
+    float best = ray.tMax;
+    uint32_t bestTri = kNoTriangle;
+    float bestU = 0.f, bestV = 0.f;
+
+    StackEntry stack[kStackSize];
+    int sp = 0;
+    stack[sp++] = { 0, 0.f };
+    while (sp > 0) {
+        const StackEntry e = stack[--sp];
+        if (e.tNear >= best)
+            continue;
+
+        if (e.child & kLeaf) {
+            const uint32_t b = e.child & ~kLeaf;
+            const TriBlock& tb = m_blocks[b];
+            f4 u, v;
+            m4 hitMask;
+            const f4 t = intersect(r.ox, r.oy, r.oz, r.dx, r.dy, r.dz, load(tb.v0x), load(tb.v0y),
+                load(tb.v0z), load(tb.e1x), load(tb.e1y), load(tb.e1z), load(tb.e2x), load(tb.e2y),
+                load(tb.e2z), splat(best), u, v, hitMask);
+            unsigned mask = bits(hitMask);
+            while (mask) {
+                const int i = lowestBit(mask);
+                mask &= mask - 1;
+                const float ti = lane(t, i);
+                if (ti < best) {
+                    best = ti;
+                    bestTri = m_blockTris[b * 4 + i];
+                    bestU = lane(u, i);
+                    bestV = lane(v, i);
+                }
+            }
+            continue;
+        }
+
+        const Node& node = m_nodes[e.child];
+        m4 hitMask;
+        const f4 tNear = slab(r.ox, r.oy, r.oz, r.ix, r.iy, r.iz, load(node.minX), load(node.minY),
+            load(node.minZ), load(node.maxX), load(node.maxY), load(node.maxZ), splat(best), hitMask);
+        alignas(16) float tn[4];
+        store(tn, tNear);
+        pushSorted(stack, sp, node.child, tn, bits(hitMask) & childMask(node));
+    }
+
+    if (bestTri == kNoTriangle)
+        return false;
+    hit.t = best;
+    hit.u = bestU;
+    hit.v = bestV;
+    hit.triangle = bestTri;
+    return true;
+}
+
+bool MeshBvh::occluded(const Ray& ray) const
+{
+    if (m_nodes.empty())
+        return false;
+    const RayLanes r(ray);
+    const f4 tMax = splat(ray.tMax);
+
+    uint32_t stack[kStackSize];
+    int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        const uint32_t child = stack[--sp];
+        if (child & kLeaf) {
+            const TriBlock& tb = m_blocks[child & ~kLeaf];
+            f4 u, v;
+            m4 hitMask;
+            intersect(r.ox, r.oy, r.oz, r.dx, r.dy, r.dz, load(tb.v0x), load(tb.v0y), load(tb.v0z),
+                load(tb.e1x), load(tb.e1y), load(tb.e1z), load(tb.e2x), load(tb.e2y), load(tb.e2z),
+                tMax, u, v, hitMask);
+            if (bits(hitMask))
+                return true;
+            continue;
+        }
+        const Node& node = m_nodes[child];
+        m4 hitMask;
+        slab(r.ox, r.oy, r.oz, r.ix, r.iy, r.iz, load(node.minX), load(node.minY), load(node.minZ),
+            load(node.maxX), load(node.maxY), load(node.maxZ), tMax, hitMask);
+        unsigned mask = bits(hitMask) & childMask(node);
+        while (mask && sp < kStackSize) {
+            const int i = lowestBit(mask);
+            mask &= mask - 1;
+            stack[sp++] = node.child[i];
+        }
+    }
+    return false;
+}
+
+unsigned MeshBvh::raycast(const RayPacket& rays, PacketHit& hits) const
+{
+    for (int i = 0; i < 4; ++i)
+        hits.triangle[i] = kNoTriangle;
+    if (m_nodes.empty())
+        return 0;
+
+    const PacketLanes r(rays);
+    f4 best = load(rays.tMax);
+    f4 bestU = splat(0.f), bestV = splat(0.f);
+    alignas(16) uint32_t bestTri[4] = { kNoTriangle, kNoTriangle, kNoTriangle, kNoTriangle };
+
+    StackEntry stack[kStackSize];
+    int sp = 0;
+    stack[sp++] = { 0, 0.f };
+    while (sp > 0) {
+        const StackEntry e = stack[--sp];
+        alignas(16) float farthest[4];
+        store(farthest, best);
+        // skip once every lane already has something closer
+        if (e.tNear >= std::max(std::max(farthest[0], farthest[1]), std::max(farthest[2], farthest[3])))
+            continue;
+
+        if (e.child & kLeaf) {
+            // four rays against each triangle of the block
+            const uint32_t b = e.child & ~kLeaf;
+            const TriBlock& tb = m_blocks[b];
+            for (int k = 0; k < 4; ++k) {
+                const uint32_t tri = m_blockTris[b * 4 + k];
+                if (tri == kNoTriangle)
+                    break; // padding only trails
+                f4 u, v;
+                m4 hitMask;
+                const f4 t = intersect(r.ox, r.oy, r.oz, r.dx, r.dy, r.dz, splat(tb.v0x[k]),
+                    splat(tb.v0y[k]), splat(tb.v0z[k]), splat(tb.e1x[k]), splat(tb.e1y[k]),
+                    splat(tb.e1z[k]), splat(tb.e2x[k]), splat(tb.e2y[k]), splat(tb.e2z[k]), best, u, v,
+                    hitMask);
+                unsigned mask = bits(hitMask);
+                if (!mask)
+                    continue;
+                best = select(hitMask, t, best);
+                bestU = select(hitMask, u, bestU);
+                bestV = select(hitMask, v, bestV);
+                while (mask) {
+                    const int i = lowestBit(mask);
+                    mask &= mask - 1;
+                    bestTri[i] = tri;
+                }
+            }
+            continue;
+        }
+
+        // each child box against all four rays
+        const Node& node = m_nodes[e.child];
+        alignas(16) float tn[4];
+        unsigned childMask = 0;
+        for (int i = 0; i < childCount(node); ++i) {
+            m4 hitMask;
+            const f4 tNear = slab(r.ox, r.oy, r.oz, r.ix, r.iy, r.iz, splat(node.minX[i]),
+                splat(node.minY[i]), splat(node.minZ[i]), splat(node.maxX[i]), splat(node.maxY[i]),
+                splat(node.maxZ[i]), best, hitMask);
+            const unsigned laneMask = bits(hitMask);
+            if (!laneMask)
+                continue;
+            childMask |= 1u << i;
+            // order by the closest entry of any ray that hits
+            alignas(16) float t[4];
+            store(t, tNear);
+            float closest = 1e30f;
+            for (int l = 0; l < 4; ++l)
+                if (laneMask & (1u << l))
+                    closest = std::min(closest, t[l]);
+            tn[i] = closest;
+        }
+        pushSorted(stack, sp, node.child, tn, childMask);
+    }
+
+    alignas(16) float t[4], u[4], v[4];
+    store(t, best);
+    store(u, bestU);
+    store(v, bestV);
+    unsigned mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        hits.t[i] = t[i];
+        hits.u[i] = u[i];
+        hits.v[i] = v[i];
+        hits.triangle[i] = bestTri[i];
+        if (bestTri[i] != kNoTriangle)
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
+template <typename NodeMask, typename Visit>
+void MeshBvh::walk(NodeMask&& nodeMask, Visit&& visit) const
+{
+    if (m_nodes.empty())
+        return;
+    uint32_t stack[kStackSize];
+    int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        const uint32_t child = stack[--sp];
+        if (child & kLeaf) {
+            visit(child & ~kLeaf);
+            continue;
+        }
+        const Node& node = m_nodes[child];
+        unsigned mask = nodeMask(node) & childMask(node);
+        while (mask && sp < kStackSize) {
+            const int i = lowestBit(mask);
+            mask &= mask - 1;
+            stack[sp++] = node.child[i];
+        }
+    }
+}
+
+void MeshBvh::queryBounds(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& out) const
+{
+    const f4 qminX = splat(boxMin.x), qminY = splat(boxMin.y), qminZ = splat(boxMin.z);
+    const f4 qmaxX = splat(boxMax.x), qmaxY = splat(boxMax.y), qmaxZ = splat(boxMax.z);
+    auto boxes = [&](const f4* mn, const f4* mx) {
+        return bits(both(both(both(le(mn[0], qmaxX), ge(mx[0], qminX)), both(le(mn[1], qmaxY), ge(mx[1], qminY))),
+            both(le(mn[2], qmaxZ), ge(mx[2], qminZ))));
+    };
+    walk(
+        [&](const Node& node) {
+            const f4 mn[3] = { load(node.minX), load(node.minY), load(node.minZ) };
+            const f4 mx[3] = { load(node.maxX), load(node.maxY), load(node.maxZ) };
+            return boxes(mn, mx);
+        },
+        [&](uint32_t b) {
+            // triangle bounds from the stored corner and edges
+            const TriBlock& tb = m_blocks[b];
+            const f4 v0[3] = { load(tb.v0x), load(tb.v0y), load(tb.v0z) };
+            const f4 v1[3] = { v0[0] + load(tb.e1x), v0[1] + load(tb.e1y), v0[2] + load(tb.e1z) };
+            const f4 v2[3] = { v0[0] + load(tb.e2x), v0[1] + load(tb.e2y), v0[2] + load(tb.e2z) };
+            f4 mn[3], mx[3];
+            for (int a = 0; a < 3; ++a) {
+                mn[a] = vmin(vmin(v0[a], v1[a]), v2[a]);
+                mx[a] = vmax(vmax(v0[a], v1[a]), v2[a]);
+            }
+            unsigned mask = boxes(mn, mx);
+            while (mask) {
+                const int i = lowestBit(mask);
+                mask &= mask - 1;
+                if (m_blockTris[b * 4 + i] != kNoTriangle)
+                    out.push_back(m_blockTris[b * 4 + i]);
+            }
+        });
+}
+
+void MeshBvh::overlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const
+{
+    const f4 cx = splat(center.x), cy = splat(center.y), cz = splat(center.z);
+    const f4 r2 = splat(radius * radius), zero = splat(0.f);
+    walk(
+        [&](const Node& node) {
+            // squared distance from the centre to each child box
+            const f4 dx = vmax(vmax(load(node.minX) - cx, cx - load(node.maxX)), zero);
+            const f4 dy = vmax(vmax(load(node.minY) - cy, cy - load(node.maxY)), zero);
+            const f4 dz = vmax(vmax(load(node.minZ) - cz, cz - load(node.maxZ)), zero);
+            return bits(le(dx * dx + dy * dy + dz * dz, r2));
+        },
+        [&](uint32_t b) {
+            const TriBlock& tb = m_blocks[b];
+            for (int i = 0; i < 4; ++i) {
+                const uint32_t tri = m_blockTris[b * 4 + i];
+                if (tri == kNoTriangle)
+                    break;
+                const glm::vec3 a(tb.v0x[i], tb.v0y[i], tb.v0z[i]);
+                const glm::vec3 e1(tb.e1x[i], tb.e1y[i], tb.e1z[i]);
+                const glm::vec3 e2(tb.e2x[i], tb.e2y[i], tb.e2z[i]);
+                if (geom::triangleOverlapsSphere(a, a + e1, a + e2, center, radius))
+                    out.push_back(tri);
+            }
+        });
+}
+
+void MeshBvh::overlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& out) const
+{
+    const f4 qminX = splat(boxMin.x), qminY = splat(boxMin.y), qminZ = splat(boxMin.z);
+    const f4 qmaxX = splat(boxMax.x), qmaxY = splat(boxMax.y), qmaxZ = splat(boxMax.z);
+    walk(
+        [&](const Node& node) {
+            const m4 x = both(le(load(node.minX), qmaxX), ge(load(node.maxX), qminX));
+            const m4 y = both(le(load(node.minY), qmaxY), ge(load(node.maxY), qminY));
+            const m4 z = both(le(load(node.minZ), qmaxZ), ge(load(node.maxZ), qminZ));
+            return bits(both(both(x, y), z));
+        },
+        [&](uint32_t b) {
+            const TriBlock& tb = m_blocks[b];
+            for (int i = 0; i < 4; ++i) {
+                const uint32_t tri = m_blockTris[b * 4 + i];
+                if (tri == kNoTriangle)
+                    break;
+                const glm::vec3 a(tb.v0x[i], tb.v0y[i], tb.v0z[i]);
+                const glm::vec3 e1(tb.e1x[i], tb.e1y[i], tb.e1z[i]);
+                const glm::vec3 e2(tb.e2x[i], tb.e2y[i], tb.e2z[i]);
+                if (geom::triangleOverlapsBox(a, a + e1, a + e2, boxMin, boxMax))
+                    out.push_back(tri);
+            }
+        });
+}
@@ -0,0 +1,115 @@
+// source/geom/MeshBvh.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+constexpr uint32_t kNoTriangle = 0xFFFFFFFF;
+
+/* Hits with t in (0, tMax) count; t is in units of `dir`, which need not be unit length. */
+struct Ray {
+    glm::vec3 origin { 0.f };
+    glm::vec3 dir { 0.f, 0.f, 1.f };
+    float tMax { 1e30f };
+};
+
+struct RayHit {
+    float t { 0.f };
+    float u { 0.f }, v { 0.f }; // barycentrics of corners 1 and 2
+    uint32_t triangle { kNoTriangle }; // index into TriMesh::indices() / 3
+};
+
+/*
+ * Four rays in SoA form for the packet traversal. A lane with tMax <= 0
+ * is inactive and never reports a hit.
+ */
+struct RayPacket {
+    float ox[4], oy[4], oz[4];
+    float dx[4], dy[4], dz[4];
+    float tMax[4];
+
+    void set(int lane, const Ray& ray);
+    void disable(int lane) { tMax[lane] = 0.f; }
+};
+
+struct PacketHit {
+    float t[4];
+    float u[4], v[4];
+    uint32_t triangle[4];
+};
+
+/*
+ * Static bounding volume hierarchy over one mesh's triangles.
+ *
+ * Built top-down with binned SAH into a binary tree, then collapsed into
+ * 4-wide nodes whose child boxes are stored SoA, so one SIMD slab test
+ * covers all four children. Leaves hold up to four triangles, stored
+ * pre-transformed (corner + two edges) in SoA blocks: a single ray tests
+ * a whole leaf at once and a packet tests four rays per triangle. Nodes
+ * and blocks live in two flat arrays in depth-first order.
+ *
+ * The tree is immutable after build() and safe to query from any number
+ * of threads. TriMesh builds one on load, see TriMesh::bvh().
+ */
+class MeshBvh {
+public:
+    void build(const std::vector<glm::vec3>& vertices, const std::vector<uint32_t>& indices);
+    void clear();
+
+    bool empty() const { return m_nodes.empty(); }
+    std::size_t nodeCount() const { return m_nodes.size(); }
+    std::size_t memoryUsage() const;
+
+    /* Closest hit; leaves `hit` untouched and returns false on a miss. */
+    bool raycast(const Ray& ray, RayHit& hit) const;
+    /* True as soon as anything is hit; cheaper for line-of-sight checks. */
+    bool occluded(const Ray& ray) const;
+    /* Closest hit per lane; misses get triangle == kNoTriangle. Returns the hit lanes as a bitmask. */
+    unsigned raycast(const RayPacket& rays, PacketHit& hits) const;
+
+    /* Appends every triangle touching the sphere / box. */
+    void overlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+    void overlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& out) const;
+
+    /* Triangles whose bounds overlap the box, without the exact test. */
+    void queryBounds(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& out) const;
+
+private:
+    struct alignas(16) Node {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        uint32_t child[4]; // kLeaf | block, node index, or kEmptySlot
+    };
+    struct alignas(16) TriBlock {
+        float v0x[4], v0y[4], v0z[4];
+        float e1x[4], e1y[4], e1z[4];
+        float e2x[4], e2y[4], e2z[4];
+    };
+    static constexpr uint32_t kLeaf = 0x80000000u;
+    static constexpr uint32_t kEmptySlot = 0xFFFFFFFFu; // only ever trailing
+
+    static int childCount(const Node& node)
+    {
+        int n = 1;
+        while (n < 4 && node.child[n] != kEmptySlot)
+            ++n;
+        return n;
+    }
+    static unsigned childMask(const Node& node) { return (1u << childCount(node)) - 1u; }
+
+    struct BuildNode;
+    struct BuildTri;
+    uint32_t flatten(const std::vector<BuildNode>& tree, uint32_t root,
+        const std::vector<BuildTri>& tris, const std::vector<uint32_t>& order);
+    uint32_t emitLeaf(const BuildNode& leaf, const std::vector<BuildTri>& tris,
+        const std::vector<uint32_t>& order);
+
+    /* Calls visit(block) for every leaf whose path passes nodeMask(node) (4-bit child mask). */
+    template <typename NodeMask, typename Visit>
+    void walk(NodeMask&& nodeMask, Visit&& visit) const;
+
+    std::vector<Node> m_nodes; // m_nodes[0] is the root
+    std::vector<TriBlock> m_blocks;
+    std::vector<uint32_t> m_blockTris; // 4 per block, kNoTriangle for padding lanes
+};
@@ -0,0 +1,237 @@
+// source/geom/SceneQuery.cpp
+#include "geom/SceneQuery.hpp"
+#include "geom/Intersect.hpp"
+#include "geom/StaticMesh.hpp"
+#include "geom/TriMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+glm::vec3 transformPoint(const glm::mat4& m, const glm::vec3& p) { return glm::vec3(m * glm::vec4(p, 1.f)); }
+glm::vec3 transformDir(const glm::mat4& m, const glm::vec3& d) { return glm::vec3(m * glm::vec4(d, 0.f)); }
+
+/* Bounds of a box after an affine transform. */
+void transformBounds(const glm::mat4& m, const glm::vec3& bmin, const glm::vec3& bmax, glm::vec3& outMin,
+    glm::vec3& outMax)
+{
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner(i & 1 ? bmax.x : bmin.x, i & 2 ? bmax.y : bmin.y, i & 4 ? bmax.z : bmin.z);
+        const glm::vec3 p = transformPoint(m, corner);
+        outMin = i ? glm::min(outMin, p) : p;
+        outMax = i ? glm::max(outMax, p) : p;
+    }
+}
+
+bool boxesOverlap(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax)
+{
+    return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y
+        && aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
+
+} // namespace
+
+void SceneQuery::build(GameObject& root)
+{
+    std::vector<const StaticMesh*> meshes;
+    collectStaticMeshes(root, meshes);
+    m_instances.clear();
+    m_instances.reserve(meshes.size());
+    for (const StaticMesh* sm : meshes) {
+        if (sm->mesh()->bvh().empty())
+            continue;
+        Instance& inst = m_instances.emplace_back();
+        inst.mesh = sm;
+        updateInstance(inst);
+    }
+}
+
+void SceneQuery::refreshTransforms()
+{
+    for (Instance& inst : m_instances)
+        updateInstance(inst);
+}
+
+void SceneQuery::updateInstance(Instance& inst) const
+{
+    const TriMesh& mesh = *inst.mesh->mesh();
+    inst.world = inst.mesh->worldMatrix();
+    inst.invWorld = glm::inverse(inst.world);
+    transformBounds(inst.world, mesh.boundsMin(), mesh.boundsMax(), inst.worldMin, inst.worldMax);
+}
+
+void SceneQuery::fillHit(const Instance& inst, const glm::vec3& origin, const glm::vec3& dir, float t,
+    uint32_t triangle, SceneRayHit& hit) const
+{
+    // normals go through the inverse transpose so non-uniform scale keeps them perpendicular
+    const glm::vec3 local = inst.mesh->mesh()->triangleNormal(triangle);
+    glm::vec3 n = glm::normalize(glm::transpose(glm::mat3(inst.invWorld)) * local);
+    if (glm::dot(n, dir) > 0.f)
+        n = -n;
+
+    hit.distance = t;
+    hit.point = origin + dir * t;
+    hit.normal = n;
+    hit.mesh = inst.mesh;
+    hit.triangle = triangle;
+}
+
+bool SceneQuery::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, SceneRayHit& hit) const
+{
+    const float len = glm::length(dir);
+    if (len <= 0.f)
+        return false;
+    const glm::vec3 d = dir / len;
+    const glm::vec3 invDir = geom::safeInverse(d);
+
+    float best = maxDistance;
+    const Instance* bestInst = nullptr;
+    uint32_t bestTri = kNoTriangle;
+    for (const Instance& inst : m_instances) {
+        float tNear, tFar;
+        if (!geom::rayOverlapsBox(origin, invDir, best, inst.worldMin, inst.worldMax, tNear, tFar))
+            continue;
+        // the direction is not renormalized, so t means the same thing in both spaces
+        Ray ray;
+        ray.origin = transformPoint(inst.invWorld, origin);
+        ray.dir = transformDir(inst.invWorld, d);
+        ray.tMax = best;
+        RayHit h;
+        if (inst.mesh->mesh()->bvh().raycast(ray, h)) {
+            best = h.t;
+            bestInst = &inst;
+            bestTri = h.triangle;
+        }
+    }
+    if (!bestInst)
+        return false;
+    fillHit(*bestInst, origin, d, best, bestTri, hit);
+    return true;
+}
+
+unsigned SceneQuery::raycast(const RayPacket& rays, SceneRayHit hits[4]) const
+{
+    float best[4];
+    const Instance* bestInst[4] = {};
+    uint32_t bestTri[4];
+    glm::vec3 origin[4], dir[4], invDir[4];
+    for (int i = 0; i < 4; ++i) {
+        best[i] = rays.tMax[i];
+        bestTri[i] = kNoTriangle;
+        origin[i] = glm::vec3(rays.ox[i], rays.oy[i], rays.oz[i]);
+        dir[i] = glm::vec3(rays.dx[i], rays.dy[i], rays.dz[i]);
+        invDir[i] = geom::safeInverse(dir[i]);
+    }
+
+    for (const Instance& inst : m_instances) {
+        RayPacket local;
+        bool any = false;
+        for (int i = 0; i < 4; ++i) {
+            float tNear, tFar;
+            if (best[i] <= 0.f
+                || !geom::rayOverlapsBox(origin[i], invDir[i], best[i], inst.worldMin, inst.worldMax, tNear, tFar)) {
+                local.disable(i);
+                local.ox[i] = local.oy[i] = local.oz[i] = 0.f;
+                local.dx[i] = local.dy[i] = local.dz[i] = 1.f;
+                continue;
+            }
+            Ray ray;
+            ray.origin = transformPoint(inst.invWorld, origin[i]);
+            ray.dir = transformDir(inst.invWorld, dir[i]);
+            ray.tMax = best[i];
+            local.set(i, ray);
+            any = true;
+        }
+        if (!any)
+            continue;
+
+        PacketHit h;
+        unsigned mask = inst.mesh->mesh()->bvh().raycast(local, h);
+        for (int i = 0; i < 4; ++i) {
+            if (mask & (1u << i)) {
+                best[i] = h.t[i];
+                bestInst[i] = &inst;
+                bestTri[i] = h.triangle[i];
+            }
+        }
+    }
+
+    unsigned mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (!bestInst[i]) {
+            hits[i] = SceneRayHit {};
+            continue;
+        }
+        fillHit(*bestInst[i], origin[i], dir[i], best[i], bestTri[i], hits[i]);
+        mask |= 1u << i;
+    }
+    return mask;
+}
+
+bool SceneQuery::occluded(const glm::vec3& from, const glm::vec3& to) const
+{
+    const glm::vec3 d = to - from;
+    const glm::vec3 invDir = geom::safeInverse(d);
+    for (const Instance& inst : m_instances) {
+        float tNear, tFar;
+        if (!geom::rayOverlapsBox(from, invDir, 1.f, inst.worldMin, inst.worldMax, tNear, tFar))
+            continue;
+        Ray ray;
+        ray.origin = transformPoint(inst.invWorld, from);
+        ray.dir = transformDir(inst.invWorld, d);
+        ray.tMax = 1.f;
+        if (inst.mesh->mesh()->bvh().occluded(ray))
+            return true;
+    }
+    return false;
+}
+
+template <typename Exact>
+void SceneQuery::overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, Exact&& exact,
+    std::vector<SceneOverlap>& out) const
+{
+    // the query's bounds in mesh space give the BVH candidates; the exact
+    // test then runs in world space where the shape is undistorted
+    std::vector<uint32_t> candidates;
+    for (const Instance& inst : m_instances) {
+        if (!boxesOverlap(boxMin, boxMax, inst.worldMin, inst.worldMax))
+            continue;
+        glm::vec3 localMin, localMax;
+        transformBounds(inst.invWorld, boxMin, boxMax, localMin, localMax);
+        candidates.clear();
+        const TriMesh& mesh = *inst.mesh->mesh();
+        mesh.bvh().queryBounds(localMin, localMax, candidates);
+
+        const std::vector<glm::vec3>& verts = mesh.vertices();
+        const std::vector<uint32_t>& idx = mesh.indices();
+        for (uint32_t tri : candidates) {
+            const glm::vec3 a = transformPoint(inst.world, verts[idx[tri * 3]]);
+            const glm::vec3 b = transformPoint(inst.world, verts[idx[tri * 3 + 1]]);
+            const glm::vec3 c = transformPoint(inst.world, verts[idx[tri * 3 + 2]]);
+            if (exact(a, b, c))
+                out.push_back({ inst.mesh, tri });
+        }
+    }
+}
+
+void SceneQuery::overlapSphere(const glm::vec3& center, float radius, std::vector<SceneOverlap>& out) const
+{
+    const glm::vec3 r(radius);
+    overlap(
+        center - r, center + r,
+        [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            return geom::triangleOverlapsSphere(a, b, c, center, radius);
+        },
+        out);
+}
+
+void SceneQuery::overlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<SceneOverlap>& out) const
+{
+    overlap(
+        boxMin, boxMax,
+        [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            return geom::triangleOverlapsBox(a, b, c, boxMin, boxMax);
+        },
+        out);
+}
@@ -0,0 +1,67 @@
+// source/geom/SceneQuery.hpp
+#pragma once
+#include "geom/MeshBvh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class GameObject;
+class StaticMesh;
+
+struct SceneRayHit {
+    float distance { 0.f }; // along the normalized direction
+    glm::vec3 point { 0.f };
+    glm::vec3 normal { 0.f }; // world space, facing back along the ray
+    const StaticMesh* mesh { nullptr };
+    uint32_t triangle { kNoTriangle };
+};
+
+struct SceneOverlap {
+    const StaticMesh* mesh;
+    uint32_t triangle;
+};
+
+/*
+ * Ray and overlap queries against every StaticMesh in a scene, for
+ * picking, line of sight and ground snapping. Each instance keeps its
+ * world matrix and inverse; rays are moved into mesh space and run
+ * against the mesh's own BVH, so instances share one tree. Results are
+ * reported in world space.
+ *
+ * Collect once with build(); after moving instances call
+ * refreshTransforms(). Queries are const and thread safe.
+ */
+class SceneQuery {
+public:
+    void build(GameObject& root);
+    void refreshTransforms();
+    void clear() { m_instances.clear(); }
+
+    std::size_t instanceCount() const { return m_instances.size(); }
+
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, SceneRayHit& hit) const;
+    /* Closest hit per lane (directions need not be normalized, distance is in their units). */
+    unsigned raycast(const RayPacket& rays, SceneRayHit hits[4]) const;
+    /* True if the segment from -> to is blocked. */
+    bool occluded(const glm::vec3& from, const glm::vec3& to) const;
+
+    void overlapSphere(const glm::vec3& center, float radius, std::vector<SceneOverlap>& out) const;
+    void overlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<SceneOverlap>& out) const;
+
+private:
+    struct Instance {
+        const StaticMesh* mesh;
+        glm::mat4 world, invWorld;
+        glm::vec3 worldMin, worldMax;
+    };
+
+    void updateInstance(Instance& inst) const;
+    void fillHit(const Instance& inst, const glm::vec3& origin, const glm::vec3& dir, float t,
+        uint32_t triangle, SceneRayHit& hit) const;
+    template <typename Exact>
+    void overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, Exact&& exact,
+        std::vector<SceneOverlap>& out) const;
+
+    std::vector<Instance> m_instances;
+};
@@ -0,0 +1,11 @@
+// source/geom/StaticMesh.cpp
+#include "geom/StaticMesh.hpp"
+
+void collectStaticMeshes(GameObject& root, std::vector<const StaticMesh*>& out)
+{
+    if (const StaticMesh* sm = root.getComponent<StaticMesh>())
+        if (sm->mesh())
+            out.push_back(sm);
+    for (auto& child : root.children())
+        collectStaticMeshes(*child, out);
+}
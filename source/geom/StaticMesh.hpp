@@ -0,0 +1,33 @@
+// source/geom/StaticMesh.hpp
+#pragma once
+#include "core/Component.hpp"
+#include "core/GameObject.hpp"
+#include "core/Transform.hpp"
+#include <vector>
+
+class TriMesh;
+
+/*
+ * Places a shared TriMesh in the world through the owner's Transform.
+ * Static level geometry is tagged with this so offline and on-load
+ * processing (navmesh baking, collision) can find it in the scene.
+ */
+class StaticMesh : public Component {
+public:
+    StaticMesh(GameObject* owner, const TriMesh* mesh)
+        : Component(owner)
+        , m_mesh(mesh)
+    {
+    }
+
+    ComponentTypeID type() const override { return componentTypeID<StaticMesh>(); }
+
+    const TriMesh* mesh() const { return m_mesh; }
+    glm::mat4 worldMatrix() const { return owner()->transform().worldMatrix(); }
+
+private:
+    const TriMesh* m_mesh;
+};
+
+/* Appends every StaticMesh in the subtree rooted at `root`. */
+void collectStaticMeshes(GameObject& root, std::vector<const StaticMesh*>& out);
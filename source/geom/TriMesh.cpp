@@ -0,0 +1,175 @@
+// source/geom/TriMesh.cpp
+#include "geom/TriMesh.hpp"
+#include "core/Logging.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t kStlHeaderBytes = 80;
+constexpr std::size_t kStlFacetBytes = 50; // normal, 3 corners, attribute word
+
+bool parseBinaryStl(const unsigned char* bytes, std::size_t size, std::vector<glm::vec3>& corners)
+{
+    if (size < kStlHeaderBytes + 4)
+        return false;
+    uint32_t count;
+    std::memcpy(&count, bytes + kStlHeaderBytes, 4);
+    if (size != kStlHeaderBytes + 4 + std::size_t(count) * kStlFacetBytes)
+        return false;
+
+    corners.resize(std::size_t(count) * 3);
+    const unsigned char* p = bytes + kStlHeaderBytes + 4;
+    for (uint32_t t = 0; t < count; ++t, p += kStlFacetBytes) {
+        float v[9];
+        std::memcpy(v, p + 12, sizeof(v)); // skip the facet normal
+        for (int c = 0; c < 3; ++c)
+            corners[t * 3 + c] = glm::vec3(v[c * 3], v[c * 3 + 1], v[c * 3 + 2]);
+    }
+    return true;
+}
+
+// Only "vertex x y z" lines carry data; facets are implied by groups of three.
+bool parseAsciiStl(const char* text, std::vector<glm::vec3>& corners)
+{
+    const char* p = text;
+    while ((p = std::strstr(p, "vertex")) != nullptr) {
+        p += 6;
+        char* end;
+        glm::vec3 v;
+        v.x = std::strtof(p, &end);
+        if (end == p)
+            return false;
+        p = end;
+        v.y = std::strtof(p, &end);
+        p = end;
+        v.z = std::strtof(p, &end);
+        p = end;
+        corners.push_back(v);
+    }
+    return !corners.empty() && corners.size() % 3 == 0;
+}
+
+struct PosKey {
+    uint32_t x, y, z;
+    bool operator==(const PosKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct PosKeyHash {
+    std::size_t operator()(const PosKey& k) const
+    {
+        return std::size_t(k.x * 73856093u ^ k.y * 19349663u ^ k.z * 83492791u);
+    }
+};
+
+} // namespace
+
+bool TriMesh::loadFromFile(const char* path)
+{
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        LOG_ERROR("TriMesh: cannot open %s", path);
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+
+    std::vector<unsigned char> buf(size > 0 ? std::size_t(size) : 0);
+    bool ok = size > 0 && std::fread(buf.data(), 1, buf.size(), f) == buf.size();
+    std::fclose(f);
+    if (!ok) {
+        LOG_ERROR("TriMesh: failed to read %s", path);
+        return false;
+    }
+    if (!loadStl(buf.data(), buf.size())) {
+        LOG_ERROR("TriMesh: %s is not a valid STL file", path);
+        return false;
+    }
+    return true;
+}
+
+bool TriMesh::loadStl(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::vector<glm::vec3> corners;
+
+    // Binary files may also start with "solid", so trust the size check
+    // first and only fall back to text parsing when it does not add up.
+    bool ok = parseBinaryStl(bytes, size, corners);
+    if (!ok && size >= 5 && std::memcmp(bytes, "solid", 5) == 0) {
+        std::string text(reinterpret_cast<const char*>(bytes), size);
+        corners.clear();
+        ok = parseAsciiStl(text.c_str(), corners);
+    }
+    if (!ok)
+        return false;
+
+    weld(corners);
+    return true;
+}
+
+void TriMesh::setData(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices)
+{
+    m_vertices = std::move(vertices);
+    m_indices = std::move(indices);
+    m_indices.resize(m_indices.size() / 3 * 3);
+    updateDerived();
+}
+
+void TriMesh::clear()
+{
+    m_vertices.clear();
+    m_indices.clear();
+    m_boundsMin = m_boundsMax = glm::vec3(0.f);
+    m_bvh.clear();
+}
+
+glm::vec3 TriMesh::triangleNormal(uint32_t triangle) const
+{
+    const glm::vec3& a = m_vertices[m_indices[triangle * 3]];
+    const glm::vec3& b = m_vertices[m_indices[triangle * 3 + 1]];
+    const glm::vec3& c = m_vertices[m_indices[triangle * 3 + 2]];
+    const glm::vec3 n = glm::cross(b - a, c - a);
+    const float len = glm::length(n);
+    return len > 0.f ? n / len : glm::vec3(0.f, 1.f, 0.f);
+}
+
+void TriMesh::weld(const std::vector<glm::vec3>& corners)
+{
+    std::unordered_map<PosKey, uint32_t, PosKeyHash> lookup;
+    lookup.reserve(corners.size() / 2);
+
+    m_vertices.clear();
+    m_indices.clear();
+    m_indices.reserve(corners.size());
+    for (const glm::vec3& c : corners) {
+        PosKey key;
+        glm::vec3 p = c + glm::vec3(0.f); // folds -0 into +0
+        std::memcpy(&key, &p, sizeof(key));
+        auto [it, inserted] = lookup.try_emplace(key, uint32_t(m_vertices.size()));
+        if (inserted)
+            m_vertices.push_back(p);
+        m_indices.push_back(it->second);
+    }
+    updateDerived();
+}
+
+void TriMesh::updateDerived()
+{
+    m_bvh.build(m_vertices, m_indices);
+    if (m_vertices.empty()) {
+        m_boundsMin = m_boundsMax = glm::vec3(0.f);
+        return;
+    }
+    m_boundsMin = m_boundsMax = m_vertices[0];
+    for (const glm::vec3& v : m_vertices) {
+        m_boundsMin = glm::min(m_boundsMin, v);
+        m_boundsMax = glm::max(m_boundsMax, v);
+    }
+}
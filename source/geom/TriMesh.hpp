@@ -0,0 +1,45 @@
+// source/geom/TriMesh.hpp
+#pragma once
+#include "geom/MeshBvh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+ * Indexed triangle mesh used by the CPU-side geometry code (navigation,
+ * collision). Loaded from binary or ASCII STL; STL repeats every corner
+ * per facet, so bit-identical positions are welded on load and shared
+ * edges end up referencing the same vertex. A MeshBvh over the triangles
+ * is rebuilt whenever the geometry changes, so ray and overlap queries
+ * are ready as soon as the mesh is.
+ */
+class TriMesh {
+public:
+    // path is usually under romfs:/, e.g. "romfs:/STLs/basic/cube.stl"
+    bool loadFromFile(const char* path);
+    bool loadStl(const void* data, std::size_t size);
+
+    /* Takes ownership of procedurally built geometry (3 indices per triangle). */
+    void setData(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices);
+    void clear();
+
+    const std::vector<glm::vec3>& vertices() const { return m_vertices; }
+    const std::vector<uint32_t>& indices() const { return m_indices; }
+    std::size_t triangleCount() const { return m_indices.size() / 3; }
+
+    const glm::vec3& boundsMin() const { return m_boundsMin; }
+    const glm::vec3& boundsMax() const { return m_boundsMax; }
+
+    const MeshBvh& bvh() const { return m_bvh; }
+    glm::vec3 triangleNormal(uint32_t triangle) const; // unit length, counter-clockwise front
+
+private:
+    void weld(const std::vector<glm::vec3>& corners);
+    void updateDerived();
+
+    std::vector<glm::vec3> m_vertices;
+    std::vector<uint32_t> m_indices;
+    glm::vec3 m_boundsMin { 0.f }, m_boundsMax { 0.f };
+    MeshBvh m_bvh;
+};
@@ -0,0 +1,218 @@
+// source/graphics/ParticleRenderer.cpp
+#include "graphics/ParticleRenderer.hpp"
+#include "core/JobSystem.hpp"
+#include "fx/ParticleEmitter.hpp"
+#include "fx/ParticleSystem.hpp"
+#include "graphics/GLUtils.hpp"
+#include "graphics/Renderer.hpp"
+
+#include <cstddef>
+#include <glm/gtc/type_ptr.hpp>
+#include <vector>
+
+static const char* const particleVertexSource = R"text(
+    attribute vec2 aCorner;
+    attribute vec3 aCenter;
+    attribute float aSize;
+    attribute vec4 aColor;
+    uniform mat4 uView;
+    uniform mat4 uProj;
+    uniform vec3 uCamRight;
+    uniform vec3 uCamUp;
+    varying vec4 vColor;
+    varying vec2 vCorner;
+    void main() {
+        vec3 p = aCenter + (uCamRight * aCorner.x + uCamUp * aCorner.y) * aSize;
+        gl_Position = uProj * uView * vec4(p, 1.0);
+        vColor = aColor;
+        vCorner = aCorner;
+    }
+)text";
+
+static const char* const particleFragmentSource = R"text(
+    precision mediump float;
+    varying vec4 vColor;
+    varying vec2 vCorner;
+    void main() {
+        float falloff = clamp(1.0 - 4.0 * dot(vCorner, vCorner), 0.0, 1.0);
+        gl_FragColor = vec4(vColor.rgb, vColor.a * falloff);
+    }
+)text";
+
+// Three segments: the CPU writes one while the GPU may still read the
+// previous two.
+static constexpr int kRingFrames = 3;
+static constexpr std::size_t kInstancesPerFrame = 64 * 1024;
+static constexpr std::size_t kSegmentBytes = kInstancesPerFrame * sizeof(ParticleInstance);
+static constexpr std::size_t kFillChunk = 4096;
+
+static GLuint s_prog = 0;
+static GLuint s_quadVbo = 0;
+static GLuint s_ringVbo = 0;
+static GLsync s_fences[kRingFrames] = {};
+static unsigned s_frame = 0;
+
+static GLint s_cornerLoc = -1;
+static GLint s_centerLoc = -1;
+static GLint s_sizeLoc = -1;
+static GLint s_colorLoc = -1;
+static GLint s_viewLoc = -1;
+static GLint s_projLoc = -1;
+static GLint s_rightLoc = -1;
+static GLint s_upLoc = -1;
+
+void particlesInit()
+{
+    GLuint vs = GLUtils::compileShader(GL_VERTEX_SHADER, particleVertexSource);
+    GLuint fs = GLUtils::compileShader(GL_FRAGMENT_SHADER, particleFragmentSource);
+    s_prog = GLUtils::linkProgram(vs, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    s_cornerLoc = glGetAttribLocation(s_prog, "aCorner");
+    s_centerLoc = glGetAttribLocation(s_prog, "aCenter");
+    s_sizeLoc = glGetAttribLocation(s_prog, "aSize");
+    s_colorLoc = glGetAttribLocation(s_prog, "aColor");
+    s_viewLoc = glGetUniformLocation(s_prog, "uView");
+    s_projLoc = glGetUniformLocation(s_prog, "uProj");
+    s_rightLoc = glGetUniformLocation(s_prog, "uCamRight");
+    s_upLoc = glGetUniformLocation(s_prog, "uCamUp");
+
+    static const GLfloat corners[] = { -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f };
+    glGenBuffers(1, &s_quadVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, s_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &s_ringVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, s_ringVbo);
+    glBufferData(GL_ARRAY_BUFFER, kRingFrames * kSegmentBytes, nullptr, GL_STREAM_DRAW);
+    GLUtils::checkError("particlesInit");
+}
+
+void particlesExit()
+{
+    for (GLsync& f : s_fences) {
+        if (f)
+            glDeleteSync(f);
+        f = nullptr;
+    }
+    glDeleteBuffers(1, &s_quadVbo);
+    glDeleteBuffers(1, &s_ringVbo);
+    glDeleteProgram(s_prog);
+}
+
+namespace {
+struct Batch {
+    const ParticleEmitter* emitter;
+    std::size_t first; // instance index inside the segment
+    std::size_t count;
+};
+struct FillChunk {
+    const ParticleEmitter* emitter;
+    std::size_t begin, end, dst;
+};
+}
+
+void particlesDraw(const ParticleSystem& system)
+{
+    static std::vector<Batch> batches;
+    static std::vector<FillChunk> chunks;
+    batches.clear();
+    chunks.clear();
+
+    // lay out this frame's segment: one contiguous run per emitter
+    std::size_t total = 0;
+    for (const ParticleEmitter* e : system.emitters()) {
+        std::size_t n = e->pool().size();
+        if (n > kInstancesPerFrame - total)
+            n = kInstancesPerFrame - total; // ring full: drop the overflow
+        if (n == 0)
+            continue;
+        batches.push_back({ e, total, n });
+        for (std::size_t b = 0; b < n; b += kFillChunk)
+            chunks.push_back({ e, b, b + kFillChunk < n ? b + kFillChunk : n, total + b });
+        total += n;
+    }
+    if (total == 0)
+        return;
+
+    const int seg = int(s_frame % kRingFrames);
+    if (GLsync f = s_fences[seg]) {
+        // only blocks if the GPU is more than kRingFrames-1 frames behind
+        while (glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) { }
+        glDeleteSync(f);
+        s_fences[seg] = nullptr;
+    }
+
+    const std::size_t segBase = std::size_t(seg) * kSegmentBytes;
+    glBindBuffer(GL_ARRAY_BUFFER, s_ringVbo);
+    auto* dst = static_cast<ParticleInstance*>(glMapBufferRange(GL_ARRAY_BUFFER,
+        GLintptr(segBase), GLsizeiptr(total * sizeof(ParticleInstance)),
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+    if (!dst) {
+        GLUtils::checkError("particlesDraw map");
+        return;
+    }
+
+    auto fill = [dst](std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; ++c)
+            chunks[c].emitter->writeInstances(chunks[c].begin, chunks[c].end, dst + chunks[c].dst);
+    };
+    if (JobSystem* jobs = system.jobs())
+        jobs->parallelFor(chunks.size(), 1, fill);
+    else
+        fill(0, chunks.size());
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    // camera basis from the view matrix rows
+    const glm::mat4& view = gfxView();
+    const glm::vec3 right(view[0][0], view[1][0], view[2][0]);
+    const glm::vec3 up(view[0][1], view[1][1], view[2][1]);
+
+    glUseProgram(s_prog);
+    glUniformMatrix4fv(s_viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(s_projLoc, 1, GL_FALSE, glm::value_ptr(gfxProj()));
+    glUniform3fv(s_rightLoc, 1, glm::value_ptr(right));
+    glUniform3fv(s_upLoc, 1, glm::value_ptr(up));
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    glBindBuffer(GL_ARRAY_BUFFER, s_quadVbo);
+    glEnableVertexAttribArray(s_cornerLoc);
+    glVertexAttribPointer(s_cornerLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, s_ringVbo);
+    glEnableVertexAttribArray(s_centerLoc);
+    glEnableVertexAttribArray(s_sizeLoc);
+    glEnableVertexAttribArray(s_colorLoc);
+    glVertexAttribDivisor(s_centerLoc, 1);
+    glVertexAttribDivisor(s_sizeLoc, 1);
+    glVertexAttribDivisor(s_colorLoc, 1);
+
+    const GLsizei stride = sizeof(ParticleInstance);
+    for (const Batch& b : batches) {
+        std::size_t base = segBase + b.first * sizeof(ParticleInstance);
+        glVertexAttribPointer(s_centerLoc, 3, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(ParticleInstance, x)));
+        glVertexAttribPointer(s_sizeLoc, 1, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(ParticleInstance, size)));
+        glVertexAttribPointer(s_colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+            (void*)(base + offsetof(ParticleInstance, rgba)));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(b.count));
+    }
+
+    glVertexAttribDivisor(s_centerLoc, 0);
+    glVertexAttribDivisor(s_sizeLoc, 0);
+    glVertexAttribDivisor(s_colorLoc, 0);
+    glDisableVertexAttribArray(s_cornerLoc);
+    glDisableVertexAttribArray(s_centerLoc);
+    glDisableVertexAttribArray(s_sizeLoc);
+    glDisableVertexAttribArray(s_colorLoc);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    s_fences[seg] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++s_frame;
+}
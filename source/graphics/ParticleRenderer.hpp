@@ -0,0 +1,13 @@
+#pragma once
+
+class ParticleSystem;
+
+/*
+ * Camera-facing particle billboards. Per-frame instance data is streamed
+ * into one ring-buffered VBO (a fenced segment per frame in flight) and
+ * each emitter is drawn with a single instanced call.
+ */
+void particlesInit(); // called from gfxInit
+void particlesExit(); // called from gfxExit
+
+void particlesDraw(const ParticleSystem& system); // between gfxBegin/gfxEnd
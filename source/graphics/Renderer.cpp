@@ -1,6 +1,8 @@
 // source/graphics/Renderer.cpp
 #include "graphics/Renderer.hpp"
 #include "graphics/GLUtils.hpp"
+#include "graphics/ParticleRenderer.hpp"
+#include "graphics/SkinnedRenderer.hpp"
 
 #include <EGL/egl.h>
 #include <glad/glad.h>
@@ -52,6 +54,12 @@ static const GLfloat s_cubePositions[36 * 3] = {
     0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, -0.5f
 };
 
+// ES3 is needed for instancing, mapped buffer ranges and fences; the
+// shaders above are GLSL ES 1.00, which ES3 contexts still accept.
+#ifndef EGL_OPENGL_ES3_BIT
+#define EGL_OPENGL_ES3_BIT 0x00000040
+#endif
+
 // -- EGL/GL state --
 static EGLDisplay s_display = EGL_NO_DISPLAY;
 static EGLContext s_context = EGL_NO_CONTEXT;
@@ -78,7 +86,7 @@ void gfxInit()
     const EGLint fb_attr[] = {
         EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
         EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8,
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
         EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
         EGL_NONE
     };
@@ -90,7 +98,7 @@ void gfxInit()
     nwindowSetSwapInterval(win, 1);
     s_surface = eglCreateWindowSurface(s_display, cfg, win, nullptr);
 
-    const EGLint ctx_attr[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+    const EGLint ctx_attr[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
     s_context = eglCreateContext(s_display, cfg, EGL_NO_CONTEXT, ctx_attr);
     eglMakeCurrent(s_display, s_surface, s_surface, s_context);
 
@@ -131,6 +139,10 @@ void gfxInit()
     s_colorLoc = glGetAttribLocation(s_prog, "aColor");
     s_viewLoc = glGetUniformLocation(s_prog, "uView");
     s_projLoc = glGetUniformLocation(s_prog, "uProj");
+
+    // 5) Secondary pipelines
+    skinnedInit();
+    particlesInit();
 }
 
 void updateViewProj(const glm::mat4& view,
@@ -140,6 +152,9 @@ void updateViewProj(const glm::mat4& view,
     s_proj = proj;
 }
 
+const glm::mat4& gfxView() { return s_view; }
+const glm::mat4& gfxProj() { return s_proj; }
+
 void gfxBegin()
 {
     glViewport(0, 0, 1280, 720);
@@ -174,6 +189,8 @@ void gfxEnd()
 
 void gfxExit()
 {
+    particlesExit();
+    skinnedExit();
     glDeleteBuffers(1, &s_vbo);
     glDeleteProgram(s_prog);
 
@@ -7,3 +7,5 @@ void gfxBegin(); // clear + begin frame
 void gfxEnd(); // swap buffers
 void gfxExit(); // cleanup
 void updateViewProj(const glm::mat4& view, const glm::mat4& proj);
+const glm::mat4& gfxView(); // matrices from the last updateViewProj
+const glm::mat4& gfxProj();
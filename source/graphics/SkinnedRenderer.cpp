@@ -0,0 +1,186 @@
+// source/graphics/SkinnedRenderer.cpp
+#include "graphics/SkinnedRenderer.hpp"
+#include "anim/Skinning.hpp"
+#include "graphics/GLUtils.hpp"
+#include "graphics/Renderer.hpp"
+
+#include <cstddef>
+#include <glm/gtc/type_ptr.hpp>
+
+// kMaxGpuJoints is baked into the shader text below
+static_assert(kMaxGpuJoints == 64, "update uBones[] in the skinning shader");
+
+static const char* const skinnedVertexSource = R"text(
+    attribute vec3 aPos;
+    attribute vec3 aNormal;
+    attribute vec4 aJoints;
+    attribute vec4 aWeights;
+    uniform mat4 uBones[64];
+    uniform mat4 uModel;
+    uniform mat4 uView;
+    uniform mat4 uProj;
+    varying vec3 vNormal;
+    void main() {
+        mat4 skin = uBones[int(aJoints.x)] * aWeights.x
+                  + uBones[int(aJoints.y)] * aWeights.y
+                  + uBones[int(aJoints.z)] * aWeights.z
+                  + uBones[int(aJoints.w)] * aWeights.w;
+        mat4 world = uModel * skin;
+        vNormal = (world * vec4(aNormal, 0.0)).xyz;
+        gl_Position = uProj * uView * world * vec4(aPos, 1.0);
+    }
+)text";
+
+// already-skinned positions and normals from the CPU path
+static const char* const cpuSkinnedVertexSource = R"text(
+    attribute vec3 aPos;
+    attribute vec3 aNormal;
+    uniform mat4 uModel;
+    uniform mat4 uView;
+    uniform mat4 uProj;
+    varying vec3 vNormal;
+    void main() {
+        vNormal = (uModel * vec4(aNormal, 0.0)).xyz;
+        gl_Position = uProj * uView * uModel * vec4(aPos, 1.0);
+    }
+)text";
+
+static const char* const skinnedFragmentSource = R"text(
+    precision mediump float;
+    uniform vec3 uColor;
+    varying vec3 vNormal;
+    void main() {
+        float light = max(dot(normalize(vNormal), normalize(vec3(0.4, 1.0, 0.6))), 0.0);
+        gl_FragColor = vec4(uColor * (0.25 + 0.75 * light), 1.0);
+    }
+)text";
+
+static GLuint s_prog = 0;
+static GLint s_posLoc = -1;
+static GLint s_normalLoc = -1;
+static GLint s_jointsLoc = -1;
+static GLint s_weightsLoc = -1;
+static GLint s_bonesLoc = -1;
+static GLint s_modelLoc = -1;
+static GLint s_viewLoc = -1;
+static GLint s_projLoc = -1;
+static GLint s_colorLoc = -1;
+
+static GLuint s_cpuProg = 0;
+static GLuint s_cpuVbo = 0;
+static GLint s_cpuPosLoc = -1;
+static GLint s_cpuNormalLoc = -1;
+static GLint s_cpuModelLoc = -1;
+static GLint s_cpuViewLoc = -1;
+static GLint s_cpuProjLoc = -1;
+static GLint s_cpuColorLoc = -1;
+
+void skinnedInit()
+{
+    GLuint vs = GLUtils::compileShader(GL_VERTEX_SHADER, skinnedVertexSource);
+    GLuint fs = GLUtils::compileShader(GL_FRAGMENT_SHADER, skinnedFragmentSource);
+    GLuint cpuVs = GLUtils::compileShader(GL_VERTEX_SHADER, cpuSkinnedVertexSource);
+    s_prog = GLUtils::linkProgram(vs, fs);
+    s_cpuProg = GLUtils::linkProgram(cpuVs, fs);
+    glDeleteShader(vs);
+    glDeleteShader(cpuVs);
+    glDeleteShader(fs);
+
+    s_posLoc = glGetAttribLocation(s_prog, "aPos");
+    s_normalLoc = glGetAttribLocation(s_prog, "aNormal");
+    s_jointsLoc = glGetAttribLocation(s_prog, "aJoints");
+    s_weightsLoc = glGetAttribLocation(s_prog, "aWeights");
+    s_bonesLoc = glGetUniformLocation(s_prog, "uBones");
+    s_modelLoc = glGetUniformLocation(s_prog, "uModel");
+    s_viewLoc = glGetUniformLocation(s_prog, "uView");
+    s_projLoc = glGetUniformLocation(s_prog, "uProj");
+    s_colorLoc = glGetUniformLocation(s_prog, "uColor");
+
+    s_cpuPosLoc = glGetAttribLocation(s_cpuProg, "aPos");
+    s_cpuNormalLoc = glGetAttribLocation(s_cpuProg, "aNormal");
+    s_cpuModelLoc = glGetUniformLocation(s_cpuProg, "uModel");
+    s_cpuViewLoc = glGetUniformLocation(s_cpuProg, "uView");
+    s_cpuProjLoc = glGetUniformLocation(s_cpuProg, "uProj");
+    s_cpuColorLoc = glGetUniformLocation(s_cpuProg, "uColor");
+    glGenBuffers(1, &s_cpuVbo);
+}
+
+void skinnedExit()
+{
+    glDeleteBuffers(1, &s_cpuVbo);
+    glDeleteProgram(s_cpuProg);
+    glDeleteProgram(s_prog);
+    s_cpuVbo = 0;
+    s_cpuProg = 0;
+    s_prog = 0;
+}
+
+void skinnedDraw(GLuint vbo, GLsizei vertexCount, const glm::mat4& model,
+    const glm::mat4* palette, std::size_t jointCount, const glm::vec3& color)
+{
+    if (jointCount > kMaxGpuJoints) {
+        LOG_WARN("skinnedDraw: %zu joints exceeds the GPU palette, use skinnedDrawCpu", jointCount);
+        return;
+    }
+
+    glUseProgram(s_prog);
+    glUniformMatrix4fv(s_bonesLoc, GLsizei(jointCount), GL_FALSE, glm::value_ptr(palette[0]));
+    glUniformMatrix4fv(s_modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(s_viewLoc, 1, GL_FALSE, glm::value_ptr(gfxView()));
+    glUniformMatrix4fv(s_projLoc, 1, GL_FALSE, glm::value_ptr(gfxProj()));
+    glUniform3fv(s_colorLoc, 1, glm::value_ptr(color));
+
+    const GLsizei stride = sizeof(SkinnedVertex);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(s_posLoc);
+    glVertexAttribPointer(s_posLoc, 3, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SkinnedVertex, position));
+    glEnableVertexAttribArray(s_normalLoc);
+    glVertexAttribPointer(s_normalLoc, 3, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SkinnedVertex, normal));
+    glEnableVertexAttribArray(s_jointsLoc);
+    glVertexAttribPointer(s_jointsLoc, 4, GL_UNSIGNED_BYTE, GL_FALSE, stride,
+        (void*)offsetof(SkinnedVertex, joints));
+    glEnableVertexAttribArray(s_weightsLoc);
+    glVertexAttribPointer(s_weightsLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+        (void*)offsetof(SkinnedVertex, weights));
+
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+
+    glDisableVertexAttribArray(s_posLoc);
+    glDisableVertexAttribArray(s_normalLoc);
+    glDisableVertexAttribArray(s_jointsLoc);
+    glDisableVertexAttribArray(s_weightsLoc);
+}
+
+void skinnedDrawCpu(const SkinnedOutput* vertices, std::size_t vertexCount,
+    const glm::mat4& model, const glm::vec3& color)
+{
+    if (vertexCount == 0)
+        return;
+
+    // orphan and refill: the previous frame's contents may still be in flight
+    const GLsizeiptr bytes = GLsizeiptr(vertexCount * sizeof(SkinnedOutput));
+    glBindBuffer(GL_ARRAY_BUFFER, s_cpuVbo);
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices);
+
+    glUseProgram(s_cpuProg);
+    glUniformMatrix4fv(s_cpuModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(s_cpuViewLoc, 1, GL_FALSE, glm::value_ptr(gfxView()));
+    glUniformMatrix4fv(s_cpuProjLoc, 1, GL_FALSE, glm::value_ptr(gfxProj()));
+    glUniform3fv(s_cpuColorLoc, 1, glm::value_ptr(color));
+
+    const GLsizei stride = sizeof(SkinnedOutput);
+    glEnableVertexAttribArray(s_cpuPosLoc);
+    glVertexAttribPointer(s_cpuPosLoc, 3, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SkinnedOutput, position));
+    glEnableVertexAttribArray(s_cpuNormalLoc);
+    glVertexAttribPointer(s_cpuNormalLoc, 3, GL_FLOAT, GL_FALSE, stride,
+        (void*)offsetof(SkinnedOutput, normal));
+
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(vertexCount));
+
+    glDisableVertexAttribArray(s_cpuPosLoc);
+    glDisableVertexAttribArray(s_cpuNormalLoc);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+/*
+ * GPU skinning path: vertices in a VBO of SkinnedVertex (anim/Skinning.hpp),
+ * joint matrices uploaded as a uniform palette each draw.
+ *
+ * Rigs that chooseSkinningPath() routes to the CPU (very small rigs, and
+ * rigs whose palette does not fit kMaxGpuJoints) are skinned with
+ * skinVertices() and drawn with skinnedDrawCpu(), which streams the
+ * SkinnedOutput through a dynamic VBO and uses the same shading.
+ */
+struct SkinnedOutput;
+
+void skinnedInit(); // called from gfxInit
+void skinnedExit(); // called from gfxExit
+
+void skinnedDraw(GLuint vbo, GLsizei vertexCount, const glm::mat4& model,
+    const glm::mat4* palette, std::size_t jointCount,
+    const glm::vec3& color = glm::vec3(0.8f));
+
+void skinnedDrawCpu(const SkinnedOutput* vertices, std::size_t vertexCount,
+    const glm::mat4& model, const glm::vec3& color = glm::vec3(0.8f));
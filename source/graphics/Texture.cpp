@@ -0,0 +1,239 @@
+// source/graphics/Texture.cpp
+#include "graphics/Texture.hpp"
+#include "graphics/GLUtils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+// Extension tokens; glad only carries them when generated with the
+// matching extensions, so provide the registry values as a fallback.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+
+static bool hasExtension(const char* name)
+{
+    const char* exts = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!exts)
+        return false;
+    std::size_t len = std::strlen(name);
+    for (const char* p = exts; (p = std::strstr(p, name)) != nullptr; p += len) {
+        bool startOk = (p == exts || p[-1] == ' ');
+        bool endOk = (p[len] == ' ' || p[len] == '\0');
+        if (startOk && endOk)
+            return true;
+    }
+    return false;
+}
+
+static bool isGLES3()
+{
+    const char* ver = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    int major = 0;
+    return ver && std::sscanf(ver, "OpenGL ES %d", &major) == 1 && major >= 3;
+}
+
+// GL internal format for a cooked format; 0 if the context lacks it.
+static GLenum glInternalFormat(TexFormat format)
+{
+    switch (format) {
+    case TexFormat::BC1:
+        return hasExtension("GL_EXT_texture_compression_s3tc")
+            ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            : 0;
+    case TexFormat::BC3:
+        return hasExtension("GL_EXT_texture_compression_s3tc")
+            ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            : 0;
+    case TexFormat::ETC2_RGB8:
+        // blocks are ETC1-compatible, so either token decodes them
+        if (isGLES3())
+            return GL_COMPRESSED_RGB8_ETC2;
+        return hasExtension("GL_OES_compressed_ETC1_RGB8_texture")
+            ? GL_ETC1_RGB8_OES
+            : 0;
+    case TexFormat::ASTC_4x4:
+        return hasExtension("GL_KHR_texture_compression_astc_ldr")
+            ? GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+            : 0;
+    case TexFormat::RGBA8:
+        return GL_RGBA;
+    }
+    return 0;
+}
+
+bool Texture::isFormatSupported(TexFormat format)
+{
+    return glInternalFormat(format) != 0;
+}
+
+Texture::~Texture() { destroy(); }
+
+Texture::Texture(Texture&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept
+{
+    if (this != &other) {
+        destroy();
+        m_id = std::exchange(other.m_id, 0);
+        m_width = other.m_width;
+        m_height = other.m_height;
+        m_format = other.m_format;
+        m_regions = std::move(other.m_regions);
+    }
+    return *this;
+}
+
+void Texture::destroy()
+{
+    if (m_id)
+        glDeleteTextures(1, &m_id);
+    m_id = 0;
+    m_width = m_height = 0;
+    m_regions.clear();
+}
+
+bool Texture::loadFromFile(const char* path)
+{
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        LOG_ERROR("Texture: cannot open %s", path);
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+
+    std::vector<unsigned char> buf(size > 0 ? std::size_t(size) : 0);
+    bool ok = size > 0 && std::fread(buf.data(), 1, buf.size(), f) == buf.size();
+    std::fclose(f);
+    if (!ok) {
+        LOG_ERROR("Texture: failed to read %s", path);
+        return false;
+    }
+    if (!loadFromMemory(buf.data(), buf.size())) {
+        LOG_ERROR("Texture: %s is not a valid .gtex", path);
+        return false;
+    }
+    return true;
+}
+
+bool Texture::loadFromMemory(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    if (size < sizeof(TexFileHeader))
+        return false;
+
+    TexFileHeader hdr;
+    std::memcpy(&hdr, bytes, sizeof(hdr));
+    if (hdr.magic != kTexMagic || hdr.version != kTexVersion
+        || hdr.dataSize != size || hdr.mipCount == 0
+        || hdr.mipCount > kTexMaxMips) {
+        LOG_ERROR("Texture: bad header");
+        return false;
+    }
+
+    auto format = TexFormat(hdr.format);
+    GLenum internal = glInternalFormat(format);
+    if (internal == 0) {
+        LOG_ERROR("Texture: format %u not supported by this GPU context",
+            unsigned(hdr.format));
+        return false;
+    }
+
+    const std::size_t mipTableEnd = sizeof(hdr) + hdr.mipCount * sizeof(TexMipLevel);
+    const std::size_t regionEnd = std::size_t(hdr.regionOffset)
+        + std::size_t(hdr.regionCount) * sizeof(TexAtlasRegion);
+    if (mipTableEnd > size || (hdr.regionCount && regionEnd > size))
+        return false;
+
+    TexMipLevel mips[kTexMaxMips];
+    std::memcpy(mips, bytes + sizeof(hdr), hdr.mipCount * sizeof(TexMipLevel));
+
+    destroy();
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    uint32_t w = hdr.width, h = hdr.height;
+    for (int level = 0; level < hdr.mipCount; ++level) {
+        const TexMipLevel& mip = mips[level];
+        if (mip.size != texLevelSize(format, w, h)
+            || std::size_t(mip.offset) + mip.size > size) {
+            LOG_ERROR("Texture: mip %d out of bounds", level);
+            destroy();
+            return false;
+        }
+        // upload straight from the file buffer
+        if (format == TexFormat::RGBA8)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, w, h, 0,
+                GL_RGBA, GL_UNSIGNED_BYTE, bytes + mip.offset);
+        else
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, internal, w, h, 0,
+                mip.size, bytes + mip.offset);
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+
+    // Atlas chains stop early to keep their gutters intact. ES3 can clamp
+    // the level range; on ES2 a partial chain is incomplete, so sample
+    // level 0 only.
+    int fullChain = 1;
+    for (uint32_t s = hdr.width > hdr.height ? hdr.width : hdr.height; s > 1; s /= 2)
+        ++fullChain;
+    bool mipmapped = hdr.mipCount == fullChain;
+    if (hdr.mipCount > 1 && !mipmapped && isGLES3()) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, hdr.mipCount - 1);
+        mipmapped = true;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+        mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    if (!GLUtils::checkError("Texture::loadFromMemory")) {
+        destroy();
+        return false;
+    }
+
+    m_width = hdr.width;
+    m_height = hdr.height;
+    m_format = format;
+    m_regions.resize(hdr.regionCount);
+    if (hdr.regionCount)
+        std::memcpy(m_regions.data(), bytes + hdr.regionOffset,
+            hdr.regionCount * sizeof(TexAtlasRegion));
+    return true;
+}
+
+void Texture::bind(GLuint unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, m_id);
+}
+
+const TexAtlasRegion* Texture::findRegion(std::string_view name) const
+{
+    for (const auto& r : m_regions)
+        if (name == std::string_view(r.name, ::strnlen(r.name, sizeof(r.name))))
+            return &r;
+    return nullptr;
+}
@@ -0,0 +1,50 @@
+// source/graphics/Texture.hpp
+#pragma once
+#include "graphics/TextureFormat.hpp"
+#include <cstddef>
+#include <glad/glad.h>
+#include <string_view>
+#include <vector>
+
+/*
+ * GPU texture loaded from a cooked .gtex file (see tools/texcook).
+ * Compressed payloads are uploaded as-is with glCompressedTexImage2D;
+ * nothing is decoded on the console. If the GPU does not expose the
+ * file's format the load fails and logs, rather than silently
+ * expanding to RGBA8.
+ */
+class Texture {
+public:
+    Texture() = default;
+    ~Texture();
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+    Texture(Texture&& other) noexcept;
+    Texture& operator=(Texture&& other) noexcept;
+
+    // path is usually under romfs:/, e.g. "romfs:/textures/ui.gtex"
+    bool loadFromFile(const char* path);
+    bool loadFromMemory(const void* data, std::size_t size);
+    void destroy();
+
+    void bind(GLuint unit = 0) const;
+
+    GLuint id() const { return m_id; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    TexFormat format() const { return m_format; }
+
+    /* Atlas lookup by source name; nullptr if absent or not an atlas. */
+    const TexAtlasRegion* findRegion(std::string_view name) const;
+    const std::vector<TexAtlasRegion>& regions() const { return m_regions; }
+
+    /* True if the current GL context can sample the given format. */
+    static bool isFormatSupported(TexFormat format);
+
+private:
+    GLuint m_id { 0 };
+    int m_width { 0 }, m_height { 0 };
+    TexFormat m_format { TexFormat::RGBA8 };
+    std::vector<TexAtlasRegion> m_regions;
+};
@@ -0,0 +1,86 @@
+// source/graphics/TextureFormat.hpp
+#pragma once
+#include <cstdint>
+
+/*
+ * On-disk layout of cooked textures (.gtex), shared by the runtime loader
+ * and tools/texcook. Everything is little-endian and laid out so the
+ * runtime can hand each mip straight to glCompressedTexImage2D:
+ *
+ *   TexFileHeader
+ *   TexMipLevel[mipCount]          (offsets are from the start of the file)
+ *   TexAtlasRegion[regionCount]    (only for atlases)
+ *   payload                        (mip 0 first, each level 16-byte aligned)
+ */
+
+constexpr uint32_t kTexMagic = 0x58455447; // "GTEX"
+constexpr uint16_t kTexVersion = 1;
+constexpr int kTexMaxMips = 16;
+
+enum class TexFormat : uint16_t {
+    RGBA8 = 0, // uncompressed fallback
+    BC1 = 1, // S3TC DXT1, opaque, 8 bytes / 4x4
+    BC3 = 2, // S3TC DXT5, 16 bytes / 4x4
+    ETC2_RGB8 = 3, // ETC1-compatible subset of ETC2, opaque, 8 bytes / 4x4
+    ASTC_4x4 = 4, // ASTC LDR 4x4, 16 bytes / 4x4
+};
+
+enum TexFlags : uint8_t {
+    TexFlag_SRGB = 1 << 0, // colour data, mips filtered in linear light
+    TexFlag_Alpha = 1 << 1, // alpha channel carries information
+};
+
+#pragma pack(push, 1)
+struct TexFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t format; // TexFormat
+    uint16_t width;
+    uint16_t height;
+    uint8_t mipCount;
+    uint8_t flags; // TexFlags
+    uint16_t regionCount;
+    uint32_t regionOffset;
+    uint32_t dataSize; // total file size, used for validation
+};
+
+struct TexMipLevel {
+    uint32_t offset;
+    uint32_t size;
+};
+
+/* UV remap entry for one source image packed into an atlas. */
+struct TexAtlasRegion {
+    char name[32]; // source file stem, NUL-terminated
+    float u0, v0, u1, v1;
+    uint16_t width, height; // size in texels at mip 0
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TexFileHeader) == 24, "TexFileHeader layout changed");
+static_assert(sizeof(TexMipLevel) == 8, "TexMipLevel layout changed");
+static_assert(sizeof(TexAtlasRegion) == 52, "TexAtlasRegion layout changed");
+
+/* Bytes per 4x4 block, or 0 for uncompressed formats. */
+constexpr uint32_t texBlockBytes(TexFormat f)
+{
+    switch (f) {
+    case TexFormat::BC1:
+    case TexFormat::ETC2_RGB8:
+        return 8;
+    case TexFormat::BC3:
+    case TexFormat::ASTC_4x4:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+/* Size in bytes of one mip level of the given dimensions. */
+constexpr uint32_t texLevelSize(TexFormat f, uint32_t w, uint32_t h)
+{
+    uint32_t block = texBlockBytes(f);
+    if (block == 0)
+        return w * h * 4;
+    return ((w + 3) / 4) * ((h + 3) / 4) * block;
+}
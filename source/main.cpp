@@ -2,20 +2,34 @@
 #include <switch.h>
 
 #include "Player.hpp"
+#include "anim/AnimationSystem.hpp"
+#include "bench/Benchmarks.hpp"
 #include "core/Camera.hpp"
 #include "core/GameObject.hpp"
+#include "core/JobSystem.hpp"
 #include "core/Logging.hpp" // initLogging(), LoggingExit()
 #include "core/Scene.hpp"
 #include "core/Transform.hpp"
+#include "fx/ParticleSystem.hpp"
+#include "graphics/ParticleRenderer.hpp"
 #include "graphics/Renderer.hpp"
 #include "input/InputSystem.hpp"
+#include "nav/NavSystem.hpp"
 
 int main(int, char**)
 {
     initLogging();
     gfxInit();
 
+    JobSystem jobs;
+#ifdef ENGINE_BENCHMARKS
+    runBenchmarks(jobs);
+#endif
+
     InputSystem input;
+    AnimationSystem animation(&jobs);
+    ParticleSystem particles(&jobs);
+    NavSystem navigation(&jobs);
     Scene scene;
 
     // 1) spawn a single object that is both player & camera
@@ -50,12 +64,16 @@ int main(int, char**)
 
         // update components
         scene.Update(dt);
+        animation.update(dt);
+        particles.update(dt);
+        navigation.update(dt);
 
         // push camera matrices to renderer
         updateViewProj(cam.viewMatrix(), cam.projectionMatrix());
 
         // draw
         gfxBegin();
+        particlesDraw(particles);
         gfxEnd();
     }
 
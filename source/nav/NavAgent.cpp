@@ -0,0 +1,73 @@
+// source/nav/NavAgent.cpp
+#include "nav/NavAgent.hpp"
+#include "core/GameObject.hpp"
+#include "core/Transform.hpp"
+#include "nav/NavSystem.hpp"
+
+#include <cmath>
+
+NavAgent::NavAgent(GameObject* owner, NavSystem* system, float speed)
+    : Component(owner)
+    , m_system(system)
+    , m_speed(speed)
+{
+    if (m_system)
+        m_system->add(this);
+}
+
+NavAgent::~NavAgent()
+{
+    if (m_system)
+        m_system->remove(this);
+}
+
+void NavAgent::setDestination(const glm::vec3& goal)
+{
+    if (!m_system)
+        return;
+    ++m_serial;
+    m_state = State::Waiting;
+    m_system->request(this, owner()->transform().position, goal);
+}
+
+void NavAgent::stop()
+{
+    ++m_serial; // drops any result still in flight
+    m_state = State::Idle;
+    m_path.clear();
+    m_next = 0;
+}
+
+void NavAgent::onPath(NavStatus status, const std::vector<glm::vec3>& points)
+{
+    if (status == NavStatus::Failed || points.empty()) {
+        stop();
+        return;
+    }
+    m_path = points;
+    m_next = 1; // points[0] is where we stood when asking
+    m_partial = status == NavStatus::Partial;
+    m_state = m_next < m_path.size() ? State::Moving : State::Idle;
+}
+
+void NavAgent::advance(float dt)
+{
+    if (m_state != State::Moving)
+        return;
+
+    glm::vec3& pos = owner()->transform().position;
+    float step = m_speed * dt;
+    while (step > 0.f && m_next < m_path.size()) {
+        glm::vec3 d = m_path[m_next] - pos;
+        float len = std::sqrt(glm::dot(d, d));
+        if (len <= step) {
+            pos = m_path[m_next++];
+            step -= len;
+        } else {
+            pos += d * (step / len);
+            step = 0.f;
+        }
+    }
+    if (m_next >= m_path.size())
+        m_state = State::Idle;
+}
@@ -0,0 +1,52 @@
+// source/nav/NavAgent.hpp
+#pragma once
+#include "core/Component.hpp"
+#include "nav/NavQuery.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class NavSystem;
+
+/*
+ * Walks the owner's Transform along navmesh paths. setDestination only
+ * queues a request; NavSystem plans it within its per-frame budget and
+ * then moves every agent along its corner points in its own update.
+ */
+class NavAgent : public Component {
+public:
+    enum class State : uint8_t {
+        Idle,
+        Waiting, // path requested, not planned yet
+        Moving,
+    };
+
+    NavAgent(GameObject* owner, NavSystem* system, float speed = 3.5f);
+    ~NavAgent() override;
+
+    ComponentTypeID type() const override { return componentTypeID<NavAgent>(); }
+
+    void setDestination(const glm::vec3& goal);
+    void stop();
+
+    void setSpeed(float speed) { m_speed = speed; }
+    float speed() const { return m_speed; }
+
+    State state() const { return m_state; }
+    const std::vector<glm::vec3>& path() const { return m_path; }
+    bool pathIsPartial() const { return m_partial; } // goal was unreachable
+
+private:
+    friend class NavSystem;
+
+    void onPath(NavStatus status, const std::vector<glm::vec3>& points);
+    void advance(float dt);
+
+    NavSystem* m_system;
+    float m_speed;
+    State m_state { State::Idle };
+    uint32_t m_serial { 0 }; // bumped per request; stale results are dropped
+    std::vector<glm::vec3> m_path;
+    std::size_t m_next { 0 }; // path corner being walked to
+    bool m_partial { false };
+};
@@ -0,0 +1,356 @@
+// source/nav/NavMesh.cpp
+#include "nav/NavMesh.hpp"
+#include "core/Logging.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+inline float cross2(float ax, float az, float bx, float bz) { return ax * bz - az * bx; }
+
+inline uint16_t quantise(float v, float step)
+{
+    float q = std::round(v / step);
+    return uint16_t(std::clamp(q, 0.f, 65535.f));
+}
+
+} // namespace
+
+void NavMesh::clear()
+{
+    m_verts.clear();
+    m_neighbours.clear();
+    m_polys.clear();
+    m_bucketStart.clear();
+    m_bucketPolys.clear();
+    m_polyBounds.clear();
+    m_bucketsX = m_bucketsZ = 0;
+    m_bmin = m_bmax = glm::vec3(0.f);
+}
+
+/* ------------------------------ file I/O ------------------------------- */
+bool NavMesh::loadFromFile(const char* path)
+{
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        LOG_ERROR("NavMesh: cannot open %s", path);
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+
+    std::vector<unsigned char> buf(size > 0 ? std::size_t(size) : 0);
+    bool ok = size > 0 && std::fread(buf.data(), 1, buf.size(), f) == buf.size();
+    std::fclose(f);
+    if (!ok) {
+        LOG_ERROR("NavMesh: failed to read %s", path);
+        return false;
+    }
+    if (!loadFromMemory(buf.data(), buf.size())) {
+        LOG_ERROR("NavMesh: %s is not a valid .gnav", path);
+        return false;
+    }
+    return true;
+}
+
+bool NavMesh::loadFromMemory(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    if (size < sizeof(NavFileHeader))
+        return false;
+
+    NavFileHeader hdr;
+    std::memcpy(&hdr, bytes, sizeof(hdr));
+    const std::size_t expected = sizeof(hdr)
+        + std::size_t(hdr.vertCount) * (sizeof(NavFileVert) + sizeof(uint32_t))
+        + std::size_t(hdr.polyCount) * sizeof(NavFilePoly);
+    if (hdr.magic != kNavMagic || hdr.version != kNavVersion
+        || hdr.dataSize != size || expected != size
+        || !(hdr.cellSize > 0.f) || !(hdr.cellHeight > 0.f)) {
+        LOG_ERROR("NavMesh: bad header");
+        return false;
+    }
+
+    clear();
+    m_origin = glm::vec3(hdr.origin[0], hdr.origin[1], hdr.origin[2]);
+    m_cellSize = hdr.cellSize;
+    m_cellHeight = hdr.cellHeight;
+
+    const unsigned char* p = bytes + sizeof(hdr);
+    m_verts.resize(hdr.vertCount);
+    for (glm::vec3& v : m_verts) {
+        NavFileVert fv;
+        std::memcpy(&fv, p, sizeof(fv));
+        p += sizeof(fv);
+        v = m_origin + glm::vec3(fv.x * m_cellSize, fv.y * m_cellHeight, fv.z * m_cellSize);
+    }
+    m_neighbours.resize(hdr.vertCount);
+    std::memcpy(m_neighbours.data(), p, hdr.vertCount * sizeof(uint32_t));
+    p += hdr.vertCount * sizeof(uint32_t);
+
+    m_polys.resize(hdr.polyCount);
+    for (NavPoly& poly : m_polys) {
+        NavFilePoly fp;
+        std::memcpy(&fp, p, sizeof(fp));
+        p += sizeof(fp);
+        if (fp.vertCount < 3 || std::size_t(fp.firstVert) + fp.vertCount > hdr.vertCount) {
+            LOG_ERROR("NavMesh: polygon out of bounds");
+            clear();
+            return false;
+        }
+        poly = { fp.firstVert, fp.vertCount, fp.flags };
+    }
+    for (uint32_t n : m_neighbours)
+        if (n != kNavNoPoly && n >= hdr.polyCount) {
+            LOG_ERROR("NavMesh: bad neighbour index");
+            clear();
+            return false;
+        }
+
+    finalize();
+    return true;
+}
+
+std::vector<unsigned char> NavMesh::serialize() const
+{
+    NavFileHeader hdr {};
+    hdr.magic = kNavMagic;
+    hdr.version = kNavVersion;
+    hdr.origin[0] = m_origin.x;
+    hdr.origin[1] = m_origin.y;
+    hdr.origin[2] = m_origin.z;
+    hdr.cellSize = m_cellSize;
+    hdr.cellHeight = m_cellHeight;
+    hdr.vertCount = uint32_t(m_verts.size());
+    hdr.polyCount = uint32_t(m_polys.size());
+    hdr.dataSize = uint32_t(sizeof(hdr)
+        + m_verts.size() * (sizeof(NavFileVert) + sizeof(uint32_t))
+        + m_polys.size() * sizeof(NavFilePoly));
+
+    std::vector<unsigned char> out(hdr.dataSize);
+    unsigned char* p = out.data();
+    std::memcpy(p, &hdr, sizeof(hdr));
+    p += sizeof(hdr);
+    for (const glm::vec3& v : m_verts) {
+        glm::vec3 g = v - m_origin;
+        NavFileVert fv { quantise(g.x, m_cellSize), quantise(g.y, m_cellHeight),
+            quantise(g.z, m_cellSize) };
+        std::memcpy(p, &fv, sizeof(fv));
+        p += sizeof(fv);
+    }
+    std::memcpy(p, m_neighbours.data(), m_neighbours.size() * sizeof(uint32_t));
+    p += m_neighbours.size() * sizeof(uint32_t);
+    for (const NavPoly& poly : m_polys) {
+        NavFilePoly fp { poly.firstVert, poly.vertCount, poly.flags };
+        std::memcpy(p, &fp, sizeof(fp));
+        p += sizeof(fp);
+    }
+    return out;
+}
+
+bool NavMesh::saveToFile(const char* path) const
+{
+    std::vector<unsigned char> data = serialize();
+    FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        LOG_ERROR("NavMesh: cannot create %s", path);
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok)
+        LOG_ERROR("NavMesh: failed to write %s", path);
+    return ok;
+}
+
+/* ------------------------------ lookup grid ---------------------------- */
+void NavMesh::finalize()
+{
+    m_bucketStart.clear();
+    m_bucketPolys.clear();
+    m_polyBounds.clear();
+    if (m_verts.empty()) {
+        m_bmin = m_bmax = glm::vec3(0.f);
+        m_bucketsX = m_bucketsZ = 0;
+        return;
+    }
+
+    m_bmin = m_bmax = m_verts[0];
+    for (const glm::vec3& v : m_verts) {
+        m_bmin = glm::min(m_bmin, v);
+        m_bmax = glm::max(m_bmax, v);
+    }
+
+    // ~16 voxels per bucket, grown if the level is huge
+    m_bucketSize = m_cellSize * 16.f;
+    auto dims = [this](float extent) { return std::max(1, int(std::ceil(extent / m_bucketSize))); };
+    while (dims(m_bmax.x - m_bmin.x) * dims(m_bmax.z - m_bmin.z) > 65536)
+        m_bucketSize *= 2.f;
+    m_bucketsX = dims(m_bmax.x - m_bmin.x);
+    m_bucketsZ = dims(m_bmax.z - m_bmin.z);
+
+    m_polyBounds.resize(m_polys.size() * 2);
+    for (std::size_t p = 0; p < m_polys.size(); ++p) {
+        const NavPoly& poly = m_polys[p];
+        glm::vec3 lo = m_verts[poly.firstVert], hi = lo;
+        for (uint32_t i = 1; i < poly.vertCount; ++i) {
+            lo = glm::min(lo, m_verts[poly.firstVert + i]);
+            hi = glm::max(hi, m_verts[poly.firstVert + i]);
+        }
+        m_polyBounds[p * 2] = lo;
+        m_polyBounds[p * 2 + 1] = hi;
+    }
+
+    // counting sort: polygon bounding rectangles into buckets
+    auto range = [this](uint32_t p, int& x0, int& z0, int& x1, int& z1) {
+        const glm::vec3& lo = m_polyBounds[p * 2];
+        const glm::vec3& hi = m_polyBounds[p * 2 + 1];
+        x0 = std::clamp(int((lo.x - m_bmin.x) / m_bucketSize), 0, m_bucketsX - 1);
+        z0 = std::clamp(int((lo.z - m_bmin.z) / m_bucketSize), 0, m_bucketsZ - 1);
+        x1 = std::clamp(int((hi.x - m_bmin.x) / m_bucketSize), 0, m_bucketsX - 1);
+        z1 = std::clamp(int((hi.z - m_bmin.z) / m_bucketSize), 0, m_bucketsZ - 1);
+    };
+
+    m_bucketStart.assign(std::size_t(m_bucketsX) * m_bucketsZ + 1, 0);
+    for (uint32_t p = 0; p < m_polys.size(); ++p) {
+        int x0, z0, x1, z1;
+        range(p, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++m_bucketStart[z * m_bucketsX + x + 1];
+    }
+    for (std::size_t i = 1; i < m_bucketStart.size(); ++i)
+        m_bucketStart[i] += m_bucketStart[i - 1];
+
+    m_bucketPolys.resize(m_bucketStart.back());
+    std::vector<uint32_t> fill(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    for (uint32_t p = 0; p < m_polys.size(); ++p) {
+        int x0, z0, x1, z1;
+        range(p, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                m_bucketPolys[fill[z * m_bucketsX + x]++] = p;
+    }
+}
+
+/* ------------------------------ geometry ------------------------------- */
+glm::vec3 NavMesh::polyCenter(uint32_t p) const
+{
+    const NavPoly& poly = m_polys[p];
+    glm::vec3 c(0.f);
+    for (uint32_t i = 0; i < poly.vertCount; ++i)
+        c += m_verts[poly.firstVert + i];
+    return c / float(poly.vertCount);
+}
+
+bool NavMesh::getPortal(uint32_t from, uint32_t to, glm::vec3& left, glm::vec3& right) const
+{
+    const NavPoly& poly = m_polys[from];
+    for (uint32_t i = 0; i < poly.vertCount; ++i) {
+        if (m_neighbours[poly.firstVert + i] != to)
+            continue;
+        // Leaving through edge a->b of a counter-clockwise polygon, b lies
+        // counter-clockwise of the walking direction (x towards z). That is
+        // the "left" NavQuery's funnel tests expect; seen from above with y
+        // up it is the walker's right hand, so do not swap these.
+        right = m_verts[poly.firstVert + i];
+        left = m_verts[poly.firstVert + (i + 1) % poly.vertCount];
+        return true;
+    }
+    return false;
+}
+
+float NavMesh::polyHeight(uint32_t p, float x, float z) const
+{
+    // triangle fan around vertex 0; the collinear splits give empty
+    // triangles, which are skipped
+    const NavPoly& poly = m_polys[p];
+    const glm::vec3& a = m_verts[poly.firstVert];
+    for (uint32_t i = 1; i + 1 < poly.vertCount; ++i) {
+        const glm::vec3& b = m_verts[poly.firstVert + i];
+        const glm::vec3& c = m_verts[poly.firstVert + i + 1];
+        float area = cross2(b.x - a.x, b.z - a.z, c.x - a.x, c.z - a.z);
+        if (area <= 1e-6f)
+            continue;
+        float u = cross2(c.x - b.x, c.z - b.z, x - b.x, z - b.z) / area;
+        float v = cross2(a.x - c.x, a.z - c.z, x - c.x, z - c.z) / area;
+        float w = 1.f - u - v;
+        if (u >= -1e-4f && v >= -1e-4f && w >= -1e-4f)
+            return u * a.y + v * b.y + w * c.y;
+    }
+    return closestPointOnPoly(p, glm::vec3(x, a.y, z)).y;
+}
+
+glm::vec3 NavMesh::closestPointOnPoly(uint32_t p, const glm::vec3& pos) const
+{
+    const NavPoly& poly = m_polys[p];
+    bool inside = true;
+    float bestD = FLT_MAX;
+    glm::vec3 best = pos;
+    for (uint32_t i = 0; i < poly.vertCount; ++i) {
+        const glm::vec3& a = m_verts[poly.firstVert + i];
+        const glm::vec3& b = m_verts[poly.firstVert + (i + 1) % poly.vertCount];
+        float ex = b.x - a.x, ez = b.z - a.z;
+        if (cross2(ex, ez, pos.x - a.x, pos.z - a.z) < 0.f)
+            inside = false;
+
+        float len2 = ex * ex + ez * ez;
+        float t = len2 > 0.f ? ((pos.x - a.x) * ex + (pos.z - a.z) * ez) / len2 : 0.f;
+        t = std::clamp(t, 0.f, 1.f);
+        glm::vec3 q = a + (b - a) * t;
+        float dx = q.x - pos.x, dz = q.z - pos.z;
+        float d = dx * dx + dz * dz;
+        if (d < bestD) {
+            bestD = d;
+            best = q;
+        }
+    }
+    if (inside)
+        return glm::vec3(pos.x, polyHeight(p, pos.x, pos.z), pos.z);
+    return best;
+}
+
+bool NavMesh::findNearestPoly(const glm::vec3& pos, const glm::vec3& extents,
+    uint32_t& poly, glm::vec3& nearest) const
+{
+    if (m_polys.empty())
+        return false;
+    glm::vec3 lo = pos - extents, hi = pos + extents;
+    if (hi.x < m_bmin.x || hi.z < m_bmin.z || lo.x > m_bmax.x || lo.z > m_bmax.z)
+        return false;
+
+    int x0 = std::clamp(int((lo.x - m_bmin.x) / m_bucketSize), 0, m_bucketsX - 1);
+    int z0 = std::clamp(int((lo.z - m_bmin.z) / m_bucketSize), 0, m_bucketsZ - 1);
+    int x1 = std::clamp(int((hi.x - m_bmin.x) / m_bucketSize), 0, m_bucketsX - 1);
+    int z1 = std::clamp(int((hi.z - m_bmin.z) / m_bucketSize), 0, m_bucketsZ - 1);
+
+    float bestD = FLT_MAX;
+    for (int z = z0; z <= z1; ++z)
+        for (int x = x0; x <= x1; ++x) {
+            const uint32_t b = uint32_t(z * m_bucketsX + x);
+            for (uint32_t i = m_bucketStart[b]; i < m_bucketStart[b + 1]; ++i) {
+                const uint32_t p = m_bucketPolys[i];
+                const glm::vec3& plo = m_polyBounds[p * 2];
+                const glm::vec3& phi = m_polyBounds[p * 2 + 1];
+                if (plo.x > hi.x || plo.y > hi.y || plo.z > hi.z
+                    || phi.x < lo.x || phi.y < lo.y || phi.z < lo.z)
+                    continue;
+                glm::vec3 q = closestPointOnPoly(p, pos);
+                glm::vec3 d = glm::abs(q - pos);
+                if (d.x > extents.x || d.y > extents.y || d.z > extents.z)
+                    continue;
+                float dist = glm::dot(q - pos, q - pos);
+                if (dist < bestD) {
+                    bestD = dist;
+                    poly = p;
+                    nearest = q;
+                }
+            }
+        }
+    return bestD != FLT_MAX;
+}
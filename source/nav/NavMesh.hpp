@@ -0,0 +1,76 @@
+// source/nav/NavMesh.hpp
+#pragma once
+#include "nav/NavMeshFormat.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct NavPoly {
+    uint32_t firstVert; // into vertices() and neighbours()
+    uint16_t vertCount;
+    uint16_t flags; // reserved for area types
+};
+
+/*
+ * Walkable surface as convex polygons, wound counter-clockwise in the
+ * x-z plane (positive signed area of x against z). Polygon edges are split wherever the neighbour changes, so
+ * every edge borders at most one other polygon and a shared edge is a
+ * portal. Built by NavMeshBuilder or loaded from a .gnav file; immutable
+ * afterwards, so any number of NavQuery objects may read it concurrently.
+ */
+class NavMesh {
+public:
+    // path is usually under romfs:/, e.g. "romfs:/nav/level1.gnav"
+    bool loadFromFile(const char* path);
+    bool loadFromMemory(const void* data, std::size_t size);
+    bool saveToFile(const char* path) const;
+    std::vector<unsigned char> serialize() const;
+
+    std::size_t polyCount() const { return m_polys.size(); }
+    const NavPoly& poly(uint32_t p) const { return m_polys[p]; }
+    const std::vector<glm::vec3>& vertices() const { return m_verts; }
+    const std::vector<uint32_t>& neighbours() const { return m_neighbours; }
+
+    glm::vec3 polyCenter(uint32_t p) const;
+
+    /* Portal endpoints from `from` into `to`. `left` is the endpoint
+     * counter-clockwise of the walking direction in the winding's sense
+     * (x towards z), which is the walker's right hand when seen from above. */
+    bool getPortal(uint32_t from, uint32_t to, glm::vec3& left, glm::vec3& right) const;
+
+    /* Surface height of polygon p at (x, z); p must contain the point. */
+    float polyHeight(uint32_t p, float x, float z) const;
+
+    /* Closest point to pos on polygon p, in 3-D. */
+    glm::vec3 closestPointOnPoly(uint32_t p, const glm::vec3& pos) const;
+
+    /* Polygon nearest to pos within +-extents; false if none. */
+    bool findNearestPoly(const glm::vec3& pos, const glm::vec3& extents,
+        uint32_t& poly, glm::vec3& nearest) const;
+
+    const glm::vec3& boundsMin() const { return m_bmin; }
+    const glm::vec3& boundsMax() const { return m_bmax; }
+    float cellSize() const { return m_cellSize; }
+    float cellHeight() const { return m_cellHeight; }
+
+private:
+    friend class NavMeshBuilder;
+
+    void clear();
+    void finalize(); // bounds and the polygon lookup grid
+
+    glm::vec3 m_origin { 0.f };
+    float m_cellSize { 0.f }, m_cellHeight { 0.f };
+    std::vector<glm::vec3> m_verts;
+    std::vector<uint32_t> m_neighbours;
+    std::vector<NavPoly> m_polys;
+
+    // derived: uniform xz buckets of overlapping polygons for point lookups
+    glm::vec3 m_bmin { 0.f }, m_bmax { 0.f };
+    std::vector<glm::vec3> m_polyBounds; // min, max per polygon
+    float m_bucketSize { 1.f };
+    int m_bucketsX { 0 }, m_bucketsZ { 0 };
+    std::vector<uint32_t> m_bucketStart; // m_bucketsX * m_bucketsZ + 1 offsets
+    std::vector<uint32_t> m_bucketPolys;
+};
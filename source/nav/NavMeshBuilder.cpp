@@ -0,0 +1,441 @@
+// source/nav/NavMeshBuilder.cpp
+#include "nav/NavMeshBuilder.hpp"
+#include "core/Logging.hpp"
+#include "geom/StaticMesh.hpp"
+#include "geom/TriMesh.hpp"
+#include "nav/NavMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint16_t kMaxHeight = 0xFFFF; // "open sky" above the top span
+constexpr int32_t kNone = -1;
+
+// neighbour directions: -x, +z, +x, -z
+constexpr int kDirX[4] = { -1, 0, 1, 0 };
+constexpr int kDirZ[4] = { 0, 1, 0, -1 };
+enum { kWest = 0, kNorth = 1, kEast = 2, kSouth = 3 };
+
+/* ----------------------------- heightfield ----------------------------- */
+struct Span {
+    uint16_t smin, smax; // in cellHeight units above the grid origin
+    uint8_t walkable;
+    int32_t next; // next span up the column
+};
+
+struct Heightfield {
+    int width = 0, depth = 0;
+    glm::vec3 bmin { 0.f };
+    float cs = 0.f, ch = 0.f;
+    std::vector<int32_t> heads; // lowest span per column
+    std::vector<Span> spans;
+    int32_t freeList = kNone;
+
+    int32_t alloc()
+    {
+        if (freeList != kNone) {
+            int32_t s = freeList;
+            freeList = spans[s].next;
+            return s;
+        }
+        spans.push_back({});
+        return int32_t(spans.size() - 1);
+    }
+
+    // Inserts [smin, smax], merging it with every span it touches. A merged
+    // top within `mergeClimb` of the old one keeps the old walkable flag too,
+    // so coplanar triangles do not flicker between walkable and not.
+    void addSpan(int x, int z, uint16_t smin, uint16_t smax, bool walkable, int mergeClimb)
+    {
+        int32_t& head = heads[x + z * width];
+        int32_t prev = kNone, cur = head;
+        uint8_t area = walkable ? 1 : 0;
+        while (cur != kNone) {
+            Span& s = spans[cur];
+            if (s.smin > smax)
+                break;
+            if (s.smax < smin) {
+                prev = cur;
+                cur = s.next;
+                continue;
+            }
+            smin = std::min(smin, s.smin);
+            smax = std::max(smax, s.smax);
+            if (std::abs(int(smax) - int(s.smax)) <= mergeClimb)
+                area = std::max(area, s.walkable);
+
+            int32_t next = s.next;
+            s.next = freeList;
+            freeList = cur;
+            if (prev == kNone)
+                head = next;
+            else
+                spans[prev].next = next;
+            cur = next;
+        }
+
+        int32_t n = alloc();
+        spans[n] = { smin, smax, area, prev == kNone ? head : spans[prev].next };
+        if (prev == kNone)
+            head = n;
+        else
+            spans[prev].next = n;
+    }
+};
+
+// Cuts convex polygon `in` at in[axis] == at; `lo` keeps the part below.
+void splitPoly(const glm::vec3* in, int n, glm::vec3* lo, int& nlo,
+    glm::vec3* hi, int& nhi, float at, int axis)
+{
+    float d[12];
+    for (int i = 0; i < n; ++i)
+        d[i] = at - in[i][axis];
+    nlo = nhi = 0;
+    for (int i = 0, j = n - 1; i < n; j = i, ++i) {
+        if ((d[j] > 0.f && d[i] < 0.f) || (d[j] < 0.f && d[i] > 0.f)) {
+            glm::vec3 v = in[j] + (in[i] - in[j]) * (d[j] / (d[j] - d[i]));
+            lo[nlo++] = v;
+            hi[nhi++] = v;
+        }
+        if (d[i] > 0.f)
+            lo[nlo++] = in[i];
+        else if (d[i] < 0.f)
+            hi[nhi++] = in[i];
+        else {
+            lo[nlo++] = in[i];
+            hi[nhi++] = in[i];
+        }
+    }
+}
+
+void rasterizeTriangle(Heightfield& hf, const glm::vec3* tri, bool walkable,
+    float maxY, int mergeClimb)
+{
+    glm::vec3 tmin = glm::min(tri[0], glm::min(tri[1], tri[2]));
+    glm::vec3 tmax = glm::max(tri[0], glm::max(tri[1], tri[2]));
+    const float cs = hf.cs;
+
+    int z0 = std::clamp(int((tmin.z - hf.bmin.z) / cs), 0, hf.depth - 1);
+    int z1 = std::clamp(int((tmax.z - hf.bmin.z) / cs), 0, hf.depth - 1);
+
+    // a triangle clipped by four planes has at most 7 corners
+    glm::vec3 bufA[12], bufB[12], row[12], cell[12], rest[12];
+    glm::vec3* in = bufA;
+    glm::vec3* remain = bufB;
+    int nin = 3;
+    in[0] = tri[0];
+    in[1] = tri[1];
+    in[2] = tri[2];
+
+    for (int z = z0; z <= z1 && nin >= 3; ++z) {
+        int nrow, nremain;
+        splitPoly(in, nin, row, nrow, remain, nremain, hf.bmin.z + (z + 1) * cs, 2);
+        std::swap(in, remain);
+        nin = nremain;
+        if (nrow < 3)
+            continue;
+
+        float rminX = row[0].x, rmaxX = row[0].x;
+        for (int i = 1; i < nrow; ++i) {
+            rminX = std::min(rminX, row[i].x);
+            rmaxX = std::max(rmaxX, row[i].x);
+        }
+        int x0 = std::clamp(int((rminX - hf.bmin.x) / cs), 0, hf.width - 1);
+        int x1 = std::clamp(int((rmaxX - hf.bmin.x) / cs), 0, hf.width - 1);
+
+        for (int x = x0; x <= x1 && nrow >= 3; ++x) {
+            int ncell, nrest;
+            splitPoly(row, nrow, cell, ncell, rest, nrest, hf.bmin.x + (x + 1) * cs, 0);
+            std::copy(rest, rest + nrest, row);
+            nrow = nrest;
+            if (ncell < 3)
+                continue;
+
+            float ymin = cell[0].y, ymax = cell[0].y;
+            for (int i = 1; i < ncell; ++i) {
+                ymin = std::min(ymin, cell[i].y);
+                ymax = std::max(ymax, cell[i].y);
+            }
+            ymin -= hf.bmin.y;
+            ymax -= hf.bmin.y;
+            if (ymax < 0.f || ymin > maxY)
+                continue;
+            ymin = std::max(ymin, 0.f);
+            ymax = std::min(ymax, maxY);
+
+            int smin = int(std::floor(ymin / hf.ch));
+            int smax = std::max(int(std::ceil(ymax / hf.ch)), smin + 1);
+            hf.addSpan(x, z, uint16_t(smin), uint16_t(std::min(smax, int(kMaxHeight) - 1)),
+                walkable, mergeClimb);
+        }
+    }
+}
+
+/* -------------------------- compact floors ---------------------------- */
+struct Floor {
+    uint16_t x, z;
+    uint16_t y; // walkable surface
+    uint16_t top; // bottom of the next solid span up, or kMaxHeight
+    int32_t con[4]; // linked floor per direction, or kNone
+    int32_t poly; // owning rectangle, kNone while unassigned
+};
+
+struct Rect {
+    int x0, z0, w, h;
+    std::vector<int32_t> cells; // floor index, row-major from (x0, z0)
+};
+
+} // namespace
+
+NavMeshBuilder::NavMeshBuilder(const NavBuildSettings& settings)
+    : m_settings(settings)
+{
+}
+
+void NavMeshBuilder::addMesh(const TriMesh& mesh, const glm::mat4& world)
+{
+    // a mirroring transform flips the winding, and with it the facing
+    const bool flip = glm::determinant(glm::mat3(world)) < 0.f;
+    const std::vector<glm::vec3>& v = mesh.vertices();
+    const std::vector<uint32_t>& idx = mesh.indices();
+
+    m_tris.reserve(m_tris.size() + idx.size());
+    for (std::size_t i = 0; i + 2 < idx.size(); i += 3) {
+        glm::vec3 a = glm::vec3(world * glm::vec4(v[idx[i]], 1.f));
+        glm::vec3 b = glm::vec3(world * glm::vec4(v[idx[i + 1]], 1.f));
+        glm::vec3 c = glm::vec3(world * glm::vec4(v[idx[i + 2]], 1.f));
+        if (flip)
+            std::swap(b, c);
+        m_tris.push_back(a);
+        m_tris.push_back(b);
+        m_tris.push_back(c);
+    }
+}
+
+void NavMeshBuilder::addScene(GameObject& root)
+{
+    std::vector<const StaticMesh*> meshes;
+    collectStaticMeshes(root, meshes);
+    for (const StaticMesh* sm : meshes)
+        addMesh(*sm->mesh(), sm->worldMatrix());
+}
+
+bool NavMeshBuilder::build(NavMesh& out) const
+{
+    const NavBuildSettings& s = m_settings;
+    out.clear();
+    if (m_tris.empty() || !(s.cellSize > 0.f) || !(s.cellHeight > 0.f)) {
+        LOG_ERROR("NavMeshBuilder: nothing to build");
+        return false;
+    }
+
+    /* 1) rasterise ------------------------------------------------------ */
+    glm::vec3 bmin = m_tris[0], bmax = m_tris[0];
+    for (const glm::vec3& p : m_tris) {
+        bmin = glm::min(bmin, p);
+        bmax = glm::max(bmax, p);
+    }
+    Heightfield hf;
+    hf.bmin = bmin;
+    hf.cs = s.cellSize;
+    hf.ch = s.cellHeight;
+    hf.width = std::max(1, int(std::ceil((bmax.x - bmin.x) / s.cellSize)));
+    hf.depth = std::max(1, int(std::ceil((bmax.z - bmin.z) / s.cellSize)));
+    const float maxY = bmax.y - bmin.y + s.agentHeight;
+    if (hf.width >= 0xFFFF || hf.depth >= 0xFFFF || maxY / s.cellHeight >= float(kMaxHeight - 1)) {
+        LOG_ERROR("NavMeshBuilder: level too large for %.2f x %.2f voxels",
+            s.cellSize, s.cellHeight);
+        return false;
+    }
+    hf.heads.assign(std::size_t(hf.width) * hf.depth, kNone);
+    hf.spans.reserve(hf.heads.size() * 2);
+
+    const int walkableHeight = int(std::ceil(s.agentHeight / s.cellHeight));
+    const int walkableClimb = int(std::floor(s.agentMaxClimb / s.cellHeight));
+    const int erodeCells = int(std::ceil(s.agentRadius / s.cellSize));
+    const float minNormalY = std::cos(glm::radians(s.agentMaxSlope));
+
+    for (std::size_t t = 0; t < m_tris.size(); t += 3) {
+        const glm::vec3* tri = &m_tris[t];
+        glm::vec3 n = glm::cross(tri[1] - tri[0], tri[2] - tri[0]);
+        float len = glm::length(n);
+        if (len <= 0.f)
+            continue;
+        rasterizeTriangle(hf, tri, n.y / len > minNormalY, maxY, 1);
+    }
+
+    /* 2) filter, link and erode ------------------------------------------ */
+    std::vector<Floor> floors;
+    std::vector<uint32_t> columnStart(hf.heads.size() + 1, 0);
+    for (std::size_t c = 0; c < hf.heads.size(); ++c) {
+        columnStart[c] = uint32_t(floors.size());
+        bool prevWalkable = false;
+        int prevTop = 0;
+        for (int32_t i = hf.heads[c]; i != kNone; i = hf.spans[i].next) {
+            Span& sp = hf.spans[i];
+            // low obstacles (kerbs, stair risers) on walkable ground are steppable
+            bool wasWalkable = sp.walkable != 0;
+            if (!wasWalkable && prevWalkable && int(sp.smax) - prevTop <= walkableClimb)
+                sp.walkable = 1;
+            prevWalkable = wasWalkable;
+            prevTop = sp.smax;
+
+            uint16_t top = sp.next != kNone ? hf.spans[sp.next].smin : kMaxHeight;
+            if (!sp.walkable || int(top) - int(sp.smax) < walkableHeight)
+                continue;
+            Floor f;
+            f.x = uint16_t(c % hf.width);
+            f.z = uint16_t(c / hf.width);
+            f.y = sp.smax;
+            f.top = top;
+            f.con[0] = f.con[1] = f.con[2] = f.con[3] = kNone;
+            f.poly = kNone;
+            floors.push_back(f);
+        }
+    }
+    columnStart.back() = uint32_t(floors.size());
+
+    for (Floor& f : floors)
+        for (int d = 0; d < 4; ++d) {
+            int nx = f.x + kDirX[d], nz = f.z + kDirZ[d];
+            if (nx < 0 || nz < 0 || nx >= hf.width || nz >= hf.depth)
+                continue;
+            const std::size_t nc = std::size_t(nx) + std::size_t(nz) * hf.width;
+            for (uint32_t j = columnStart[nc]; j < columnStart[nc + 1]; ++j) {
+                const Floor& g = floors[j];
+                int bot = std::max(f.y, g.y), top = std::min(f.top, g.top);
+                if (top - bot >= walkableHeight && std::abs(int(g.y) - int(f.y)) <= walkableClimb) {
+                    f.con[d] = int32_t(j);
+                    break;
+                }
+            }
+        }
+
+    if (erodeCells > 0) {
+        // breadth-first distance from the nearest unlinked edge
+        std::vector<int> dist(floors.size(), -1);
+        std::vector<int32_t> queue;
+        queue.reserve(floors.size());
+        for (std::size_t i = 0; i < floors.size(); ++i) {
+            const Floor& f = floors[i];
+            if (f.con[0] == kNone || f.con[1] == kNone || f.con[2] == kNone || f.con[3] == kNone) {
+                dist[i] = 0;
+                queue.push_back(int32_t(i));
+            }
+        }
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            const Floor& f = floors[queue[q]];
+            if (dist[queue[q]] + 1 >= erodeCells)
+                continue; // everything further in survives anyway
+            for (int32_t n : f.con)
+                if (n != kNone && dist[n] < 0) {
+                    dist[n] = dist[queue[q]] + 1;
+                    queue.push_back(n);
+                }
+        }
+        for (Floor& f : floors)
+            for (int32_t& n : f.con)
+                if (n != kNone && dist[n] >= 0 && dist[n] < erodeCells)
+                    n = kNone;
+        for (std::size_t i = 0; i < floors.size(); ++i)
+            if (dist[i] >= 0 && dist[i] < erodeCells)
+                floors[i].poly = -2; // eroded away
+    }
+
+    /* 3) rectangles --------------------------------------------------------- */
+    const int maxCells = std::clamp(s.maxPolyCells, 1, 256);
+    auto freeFloor = [&floors](int32_t i) { return i != kNone && floors[i].poly == kNone; };
+
+    // Each rectangle starts at the first free floor in scan order. Rows
+    // are stacked along +z, each no wider than the one below, and the
+    // stack height with the largest area wins; this keeps polygons close
+    // to square instead of thin strips along obstacle edges.
+    std::vector<int32_t> grid(std::size_t(maxCells) * maxCells);
+    std::vector<Rect> rects;
+    for (std::size_t i = 0; i < floors.size(); ++i) {
+        if (floors[i].poly != kNone)
+            continue;
+
+        int rowWidth = 0, bestW = 0, bestH = 0;
+        for (int row = 0; row < maxCells; ++row) {
+            int32_t* cells = &grid[std::size_t(row) * maxCells];
+            const int32_t* below = row > 0 ? cells - maxCells : nullptr;
+            int32_t n = row == 0 ? int32_t(i) : floors[below[0]].con[kNorth];
+            int limit = row == 0 ? maxCells : rowWidth;
+            int w = 0;
+            for (; w < limit && freeFloor(n); n = floors[n].con[kEast]) {
+                if (below && floors[below[w]].con[kNorth] != n)
+                    break;
+                cells[w++] = n;
+            }
+            if (w == 0)
+                break;
+            rowWidth = w;
+            if (w * (row + 1) > bestW * bestH) {
+                bestW = w;
+                bestH = row + 1;
+            }
+        }
+
+        const int32_t id = int32_t(rects.size());
+        Rect r { floors[i].x, floors[i].z, bestW, bestH, {} };
+        r.cells.reserve(std::size_t(bestW) * bestH);
+        for (int row = 0; row < bestH; ++row)
+            for (int k = 0; k < bestW; ++k) {
+                int32_t c = grid[std::size_t(row) * maxCells + k];
+                floors[c].poly = id;
+                r.cells.push_back(c);
+            }
+        rects.push_back(std::move(r));
+    }
+    if (rects.empty()) {
+        LOG_ERROR("NavMeshBuilder: no walkable area");
+        return false;
+    }
+
+    /* 4) polygons ------------------------------------------------------------ */
+    out.m_origin = bmin;
+    out.m_cellSize = s.cellSize;
+    out.m_cellHeight = s.cellHeight;
+    out.m_polys.reserve(rects.size());
+
+    for (const Rect& r : rects) {
+        NavPoly poly { uint32_t(out.m_verts.size()), 0, 0 };
+        uint32_t lastNeighbour = 0;
+
+        // One side of the rectangle: `count` cells, the k-th at cellAt(k),
+        // its outside neighbour in direction `dir`; each run of equal
+        // neighbours starts an edge at corner(k).
+        auto side = [&](int count, int dir, auto cellAt, auto corner) {
+            for (int k = 0; k < count; ++k) {
+                const Floor& f = floors[cellAt(k)];
+                int32_t n = f.con[dir];
+                uint32_t nb = n != kNone ? uint32_t(floors[n].poly) : kNavNoPoly;
+                if (k > 0 && nb == lastNeighbour)
+                    continue;
+                glm::ivec2 g = corner(k);
+                out.m_verts.push_back(bmin + glm::vec3(g.x * s.cellSize, f.y * s.cellHeight, g.y * s.cellSize));
+                out.m_neighbours.push_back(nb);
+                lastNeighbour = nb;
+            }
+        };
+        const int w = r.w, h = r.h;
+        auto cell = [&r, w](int x, int z) { return r.cells[std::size_t(z) * w + x]; };
+        side(w, kSouth, [&](int k) { return cell(k, 0); },
+            [&](int k) { return glm::ivec2(r.x0 + k, r.z0); });
+        side(h, kEast, [&](int k) { return cell(w - 1, k); },
+            [&](int k) { return glm::ivec2(r.x0 + w, r.z0 + k); });
+        side(w, kNorth, [&](int k) { return cell(w - 1 - k, h - 1); },
+            [&](int k) { return glm::ivec2(r.x0 + w - k, r.z0 + h); });
+        side(h, kWest, [&](int k) { return cell(0, h - 1 - k); },
+            [&](int k) { return glm::ivec2(r.x0, r.z0 + h - k); });
+
+        poly.vertCount = uint16_t(out.m_verts.size() - poly.firstVert);
+        out.m_polys.push_back(poly);
+    }
+
+    out.finalize();
+    return true;
+}
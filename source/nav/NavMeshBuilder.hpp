@@ -0,0 +1,47 @@
+// source/nav/NavMeshBuilder.hpp
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+class GameObject;
+class NavMesh;
+class TriMesh;
+
+struct NavBuildSettings {
+    float cellSize { 0.2f }; // horizontal voxel size (m)
+    float cellHeight { 0.1f }; // vertical voxel size (m)
+    float agentHeight { 1.8f }; // minimum clearance above walkable ground
+    float agentRadius { 0.4f }; // walls are pushed back by this much
+    float agentMaxClimb { 0.4f }; // highest step the agent walks over
+    float agentMaxSlope { 45.f }; // degrees
+    int maxPolyCells { 24 }; // longest polygon side, in cells (max 256)
+};
+
+/*
+ * Bakes a NavMesh from world-space triangles, either offline (bake once
+ * and NavMesh::saveToFile) or while a level loads:
+ *
+ *   1. rasterise every triangle into a column heightfield of solid spans,
+ *      flagging the tops of gently sloped ones as walkable;
+ *   2. drop floors without head room, link floors in neighbouring columns
+ *      the agent can step between, and erode by the agent radius;
+ *   3. greedily merge linked floors into rectangles and emit each as a
+ *      convex polygon whose edges are split wherever the neighbour changes.
+ */
+class NavMeshBuilder {
+public:
+    explicit NavMeshBuilder(const NavBuildSettings& settings = {});
+
+    void addMesh(const TriMesh& mesh, const glm::mat4& world);
+    void addScene(GameObject& root); // every StaticMesh below root
+    void clear() { m_tris.clear(); }
+
+    std::size_t triangleCount() const { return m_tris.size() / 3; }
+
+    bool build(NavMesh& out) const;
+
+private:
+    NavBuildSettings m_settings;
+    std::vector<glm::vec3> m_tris; // world space, three corners each
+};
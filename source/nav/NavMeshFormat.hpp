@@ -0,0 +1,47 @@
+// source/nav/NavMeshFormat.hpp
+#pragma once
+#include <cstdint>
+
+/*
+ * On-disk layout of baked navigation meshes (.gnav). Vertices sit on the
+ * voxel grid used for baking, so they are stored losslessly as grid
+ * coordinates relative to the mesh origin:
+ *
+ *   NavFileHeader
+ *   NavFileVert[vertCount]
+ *   uint32_t neighbour[vertCount]   (edge i of a polygon runs from its
+ *                                    vertex i to i+1; kNavNoPoly = wall)
+ *   NavFilePoly[polyCount]
+ */
+
+constexpr uint32_t kNavMagic = 0x56414E47; // "GNAV"
+constexpr uint16_t kNavVersion = 1;
+constexpr uint32_t kNavNoPoly = 0xFFFFFFFFu;
+
+#pragma pack(push, 1)
+struct NavFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    float origin[3]; // world position of grid coordinate (0, 0, 0)
+    float cellSize; // horizontal grid step
+    float cellHeight; // vertical grid step
+    uint32_t vertCount;
+    uint32_t polyCount;
+    uint32_t dataSize; // total file size, used for validation
+};
+
+struct NavFileVert {
+    uint16_t x, y, z;
+};
+
+struct NavFilePoly {
+    uint32_t firstVert;
+    uint16_t vertCount;
+    uint16_t flags;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(NavFileHeader) == 40, "NavFileHeader layout changed");
+static_assert(sizeof(NavFileVert) == 6, "NavFileVert layout changed");
+static_assert(sizeof(NavFilePoly) == 8, "NavFilePoly layout changed");
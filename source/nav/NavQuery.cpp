@@ -0,0 +1,406 @@
+// source/nav/NavQuery.cpp
+#include "nav/NavQuery.hpp"
+#include "nav/NavMesh.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t kNotInHeap = 0xFFFFFFFFu;
+
+inline float cross2(const glm::vec3& a, const glm::vec3& b) { return a.x * b.z - a.z * b.x; }
+
+// Sine of the x-z angle from a to b: a side test whose collinear
+// tolerance does not depend on how far the points are from the apex.
+inline float turn(const glm::vec3& a, const glm::vec3& b)
+{
+    const float len2 = (a.x * a.x + a.z * a.z) * (b.x * b.x + b.z * b.z);
+    return len2 > 0.f ? cross2(a, b) / std::sqrt(len2) : 0.f;
+}
+
+constexpr float kCollinear = 1e-4f;
+
+inline bool sameXZ(const glm::vec3& a, const glm::vec3& b)
+{
+    float dx = a.x - b.x, dz = a.z - b.z;
+    return dx * dx + dz * dz < 1e-8f;
+}
+
+} // namespace
+
+NavQuery::NavQuery(const NavMesh* mesh)
+    : m_mesh(nullptr)
+{
+    setMesh(mesh);
+}
+
+void NavQuery::setMesh(const NavMesh* mesh)
+{
+    m_mesh = mesh;
+    m_nodes.assign(mesh ? mesh->polyCount() : 0, Node {});
+    m_heap.clear();
+    m_stamp = 0;
+    m_status = NavStatus::Failed;
+}
+
+NavQuery::Node& NavQuery::node(uint32_t p)
+{
+    Node& n = m_nodes[p];
+    if (n.stamp != m_stamp) {
+        n.g = FLT_MAX;
+        n.f = FLT_MAX;
+        n.parent = kNavNoPoly;
+        n.stamp = m_stamp;
+        n.closed = 0;
+        n.heapIndex = kNotInHeap;
+    }
+    return n;
+}
+
+/* ------------------------------ open list ------------------------------ */
+void NavQuery::heapUp(uint32_t i)
+{
+    const uint32_t p = m_heap[i];
+    const float f = m_nodes[p].f;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (m_nodes[m_heap[parent]].f <= f)
+            break;
+        m_heap[i] = m_heap[parent];
+        m_nodes[m_heap[i]].heapIndex = i;
+        i = parent;
+    }
+    m_heap[i] = p;
+    m_nodes[p].heapIndex = i;
+}
+
+void NavQuery::heapDown(uint32_t i)
+{
+    const uint32_t p = m_heap[i];
+    const float f = m_nodes[p].f;
+    const uint32_t n = uint32_t(m_heap.size());
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && m_nodes[m_heap[child + 1]].f < m_nodes[m_heap[child]].f)
+            ++child;
+        if (m_nodes[m_heap[child]].f >= f)
+            break;
+        m_heap[i] = m_heap[child];
+        m_nodes[m_heap[i]].heapIndex = i;
+        i = child;
+    }
+    m_heap[i] = p;
+    m_nodes[p].heapIndex = i;
+}
+
+void NavQuery::heapPush(uint32_t p)
+{
+    m_heap.push_back(p);
+    heapUp(uint32_t(m_heap.size() - 1));
+}
+
+uint32_t NavQuery::heapPop()
+{
+    uint32_t top = m_heap[0];
+    m_nodes[top].heapIndex = kNotInHeap;
+    m_heap[0] = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+        heapDown(0);
+    return top;
+}
+
+/* -------------------------------- A* ---------------------------------- */
+NavStatus NavQuery::findPath(uint32_t startPoly, uint32_t endPoly, const glm::vec3& startPos,
+    const glm::vec3& endPos, std::vector<uint32_t>& corridor)
+{
+    beginPath(startPoly, endPoly, startPos, endPos);
+    updatePath(INT_MAX);
+    return finishPath(corridor);
+}
+
+NavStatus NavQuery::beginPath(uint32_t startPoly, uint32_t endPoly, const glm::vec3& startPos,
+    const glm::vec3& endPos)
+{
+    m_heap.clear();
+    if (!m_mesh || startPoly >= m_nodes.size() || endPoly >= m_nodes.size())
+        return m_status = NavStatus::Failed;
+
+    if (++m_stamp == 0) { // wrapped: stale stamps could alias
+        for (Node& n : m_nodes)
+            n.stamp = 0;
+        m_stamp = 1;
+    }
+    m_startPoly = startPoly;
+    m_endPoly = endPoly;
+    m_endPos = endPos;
+
+    Node& start = node(startPoly);
+    start.g = 0.f;
+    start.pos = startPos;
+    m_bestH = glm::distance(startPos, endPos);
+    m_bestPoly = startPoly;
+    start.f = m_bestH;
+    heapPush(startPoly);
+
+    return m_status = startPoly == endPoly ? NavStatus::Success : NavStatus::InProgress;
+}
+
+NavStatus NavQuery::updatePath(int maxIterations, int* doneIterations)
+{
+    int iterations = 0;
+    while (m_status == NavStatus::InProgress && iterations < maxIterations) {
+        if (m_heap.empty()) {
+            m_status = NavStatus::Partial;
+            break;
+        }
+        const uint32_t cur = heapPop();
+        ++iterations;
+        Node& c = m_nodes[cur];
+        c.closed = 1;
+        if (cur == m_endPoly) {
+            m_status = NavStatus::Success;
+            break;
+        }
+
+        const NavPoly& poly = m_mesh->poly(cur);
+        const std::vector<glm::vec3>& verts = m_mesh->vertices();
+        for (uint32_t i = 0; i < poly.vertCount; ++i) {
+            const uint32_t nb = m_mesh->neighbours()[poly.firstVert + i];
+            if (nb == kNavNoPoly || nb == c.parent)
+                continue;
+            Node& n = node(nb);
+            if (n.closed)
+                continue;
+
+            // Cost runs between the points where the path crosses each
+            // portal, taken as the portal point closest to where we entered
+            // this polygon. Much closer to the string-pulled length than
+            // centroids or midpoints when polygons are long and thin.
+            const glm::vec3& a = verts[poly.firstVert + i];
+            const glm::vec3& b = verts[poly.firstVert + (i + 1) % poly.vertCount];
+            const glm::vec3 ab = b - a;
+            const float len2 = glm::dot(ab, ab);
+            const float t = len2 > 0.f ? std::clamp(glm::dot(c.pos - a, ab) / len2, 0.f, 1.f) : 0.f;
+            const glm::vec3 entry = a + ab * t;
+            float g = c.g + glm::distance(c.pos, entry);
+            float h = glm::distance(entry, m_endPos);
+            if (nb == m_endPoly) {
+                g += h;
+                h = 0.f;
+            }
+            if (g >= n.g)
+                continue;
+
+            n.g = g;
+            n.f = g + h;
+            n.pos = entry;
+            n.parent = cur;
+            if (n.heapIndex == kNotInHeap)
+                heapPush(nb);
+            else
+                heapUp(n.heapIndex);
+
+            if (h < m_bestH) {
+                m_bestH = h;
+                m_bestPoly = nb;
+            }
+        }
+    }
+    if (doneIterations)
+        *doneIterations = iterations;
+    return m_status;
+}
+
+NavStatus NavQuery::finishPath(std::vector<uint32_t>& corridor)
+{
+    corridor.clear();
+    if (m_status == NavStatus::InProgress)
+        return m_status;
+    if (m_status == NavStatus::Failed)
+        return m_status;
+
+    uint32_t p = m_status == NavStatus::Success ? m_endPoly : m_bestPoly;
+    for (; p != kNavNoPoly; p = m_nodes[p].parent)
+        corridor.push_back(p);
+    std::reverse(corridor.begin(), corridor.end());
+    return m_status;
+}
+
+/* --------------------------- string pulling ---------------------------- */
+void NavQuery::straightPath(const std::vector<uint32_t>& corridor, const glm::vec3& startPos,
+    const glm::vec3& endPos, std::vector<glm::vec3>& points)
+{
+    points.clear();
+    if (!m_mesh || corridor.empty())
+        return;
+
+    // a partial corridor stops short of the goal, so aim for its end instead
+    const glm::vec3 start = m_mesh->closestPointOnPoly(corridor.front(), startPos);
+    const glm::vec3 end = m_mesh->closestPointOnPoly(corridor.back(), endPos);
+
+    // portal i lies between corridor[i-1] and corridor[i]; the start and
+    // end points act as zero-width portals at either end
+    m_portalLeft.clear();
+    m_portalRight.clear();
+    m_portalLeft.push_back(start);
+    m_portalRight.push_back(start);
+    for (std::size_t i = 0; i + 1 < corridor.size(); ++i) {
+        glm::vec3 l, r;
+        if (!m_mesh->getPortal(corridor[i], corridor[i + 1], l, r))
+            break;
+        m_portalLeft.push_back(l);
+        m_portalRight.push_back(r);
+    }
+    m_portalLeft.push_back(end);
+    m_portalRight.push_back(end);
+
+    // Funnel: keep the widest wedge from the apex that fits through every
+    // portal so far. When one side crosses the other, the crossed side's
+    // endpoint is a corner and becomes the new apex. A side that only
+    // closes onto the other (collinear, as when the path runs along
+    // polygon edges or through their corners) is not a crossing.
+    glm::vec3 apex = start, left = start, right = start;
+    std::size_t leftIdx = 0, rightIdx = 0;
+    m_pointPortals.clear();
+    points.push_back(start);
+    m_pointPortals.push_back(0);
+
+    const std::size_t n = m_portalLeft.size();
+    for (std::size_t i = 1; i < n; ++i) {
+        const glm::vec3& l = m_portalLeft[i];
+        const glm::vec3& r = m_portalRight[i];
+
+        if (cross2(right - apex, r - apex) >= 0.f) { // right side narrows
+            if (sameXZ(apex, right) || turn(r - apex, left - apex) > -kCollinear) {
+                right = r;
+                rightIdx = i;
+            } else {
+                apex = left;
+                if (!sameXZ(points.back(), apex)) {
+                    points.push_back(apex);
+                    m_pointPortals.push_back(leftIdx);
+                }
+                right = apex;
+                i = rightIdx = leftIdx;
+                continue;
+            }
+        }
+        if (cross2(left - apex, l - apex) <= 0.f) { // left side narrows
+            if (sameXZ(apex, left) || turn(right - apex, l - apex) > -kCollinear) {
+                left = l;
+                leftIdx = i;
+            } else {
+                apex = right;
+                if (!sameXZ(points.back(), apex)) {
+                    points.push_back(apex);
+                    m_pointPortals.push_back(rightIdx);
+                }
+                left = apex;
+                i = leftIdx = rightIdx;
+                continue;
+            }
+        }
+    }
+    if (!sameXZ(points.back(), end) || points.size() == 1) {
+        points.push_back(end);
+        m_pointPortals.push_back(n - 1);
+    }
+
+    // The funnel is only as straight as its corridor, and A* over a grid
+    // of equally cheap polygons often returns a staircase. Drop every
+    // corner the walk can cut past in a straight line, collinear ones
+    // included.
+    std::size_t kept = 1;
+    for (std::size_t from = 0; from + 1 < points.size();) {
+        std::size_t to = points.size() - 1;
+        while (to > from + 1 && !canWalk(corridor, m_pointPortals[from], points[from], points[to]))
+            --to;
+        points[kept++] = points[to];
+        from = to;
+    }
+    points.resize(kept);
+}
+
+bool NavQuery::canWalk(const std::vector<uint32_t>& corridor, std::size_t portal, const glm::vec3& from,
+    const glm::vec3& to) const
+{
+    // portal i leads into corridor[i]; the walk must stay on the path's
+    // level, so it has to end on a corridor polygon
+    NavRayHit hit;
+    if (raycast(corridor[std::min(portal, corridor.size() - 1)], from, to, hit))
+        return false;
+    return std::find(corridor.begin(), corridor.end(), hit.poly) != corridor.end();
+}
+
+/* ------------------------------ raycast -------------------------------- */
+bool NavQuery::raycast(uint32_t startPoly, const glm::vec3& startPos, const glm::vec3& endPos,
+    NavRayHit& hit) const
+{
+    hit = NavRayHit {};
+    hit.poly = startPoly;
+    if (!m_mesh || startPoly >= m_mesh->polyCount())
+        return false;
+
+    const std::vector<glm::vec3>& verts = m_mesh->vertices();
+    const glm::vec3 dir = endPos - startPos;
+    uint32_t cur = startPoly;
+
+    for (std::size_t step = 0; step <= m_mesh->polyCount(); ++step) {
+        const NavPoly& poly = m_mesh->poly(cur);
+
+        // Where the segment leaves this (convex) polygon: the smallest t
+        // over edges it crosses outwards. Collinear split edges tie on t,
+        // so keep the one whose span actually contains the exit point.
+        float exitT = FLT_MAX;
+        uint32_t exitEdge = 0;
+        float exitSpan = FLT_MAX;
+        for (uint32_t i = 0; i < poly.vertCount; ++i) {
+            const glm::vec3& a = verts[poly.firstVert + i];
+            const glm::vec3& b = verts[poly.firstVert + (i + 1) % poly.vertCount];
+            const float ex = b.x - a.x, ez = b.z - a.z;
+            const float den = ez * dir.x - ex * dir.z; // outward normal (ez, -ex) . dir
+            if (den <= 1e-9f)
+                continue;
+            const float t = (ez * (a.x - startPos.x) - ex * (a.z - startPos.z)) / den;
+            if (t > exitT + 1e-5f)
+                continue;
+
+            const float px = startPos.x + dir.x * t - a.x, pz = startPos.z + dir.z * t - a.z;
+            const float s = (px * ex + pz * ez) / (ex * ex + ez * ez);
+            const float outside = std::max(0.f, std::max(-s, s - 1.f));
+            if (t < exitT - 1e-5f || outside < exitSpan) {
+                exitT = std::min(t, exitT);
+                exitEdge = i;
+                exitSpan = outside;
+            }
+        }
+
+        hit.poly = cur;
+        if (exitT >= 1.f)
+            return false; // end point is inside this polygon
+
+        const uint32_t nb = m_mesh->neighbours()[poly.firstVert + exitEdge];
+        if (nb == kNavNoPoly) {
+            const glm::vec3& a = verts[poly.firstVert + exitEdge];
+            const glm::vec3& b = verts[poly.firstVert + (exitEdge + 1) % poly.vertCount];
+            hit.t = std::max(exitT, 0.f);
+            // the edge's inward normal, so it faces back along the ray
+            hit.normal = glm::normalize(glm::vec3(a.z - b.z, 0.f, b.x - a.x));
+            return true;
+        }
+        cur = nb;
+    }
+    return false;
+}
+
+bool NavQuery::findNearestPoly(const glm::vec3& pos, const glm::vec3& extents,
+    uint32_t& poly, glm::vec3& nearest) const
+{
+    return m_mesh && m_mesh->findNearestPoly(pos, extents, poly, nearest);
+}
@@ -0,0 +1,89 @@
+// source/nav/NavQuery.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class NavMesh;
+
+enum class NavStatus : uint8_t {
+    InProgress,
+    Success,
+    Partial, // goal unreachable; path ends at the closest reachable polygon
+    Failed,
+};
+
+struct NavRayHit {
+    float t { 1.f }; // fraction of start->end travelled before the hit
+    glm::vec3 normal { 0.f }; // wall normal in the x-z plane, into the walkable area
+    uint32_t poly { 0 }; // last polygon reached
+};
+
+/*
+ * Search state over one NavMesh. A* scratch is sized to the polygon
+ * count and reused between queries, so keep one NavQuery per thread and
+ * do not share it. The mesh itself is read-only.
+ *
+ * A path search can run in one go (findPath) or be time-sliced: begin it,
+ * call updatePath with an iteration budget until it stops returning
+ * InProgress, then collect the polygon corridor with finishPath.
+ */
+class NavQuery {
+public:
+    explicit NavQuery(const NavMesh* mesh = nullptr);
+
+    void setMesh(const NavMesh* mesh);
+    const NavMesh* mesh() const { return m_mesh; }
+
+    NavStatus findPath(uint32_t startPoly, uint32_t endPoly, const glm::vec3& startPos,
+        const glm::vec3& endPos, std::vector<uint32_t>& corridor);
+
+    NavStatus beginPath(uint32_t startPoly, uint32_t endPoly, const glm::vec3& startPos,
+        const glm::vec3& endPos);
+    NavStatus updatePath(int maxIterations, int* doneIterations = nullptr);
+    NavStatus finishPath(std::vector<uint32_t>& corridor);
+
+    /* String-pulls a corridor into corner points, start and end included.
+     * Both ends are clamped onto the first and last corridor polygons. */
+    void straightPath(const std::vector<uint32_t>& corridor, const glm::vec3& startPos,
+        const glm::vec3& endPos, std::vector<glm::vec3>& points);
+
+    /* Walks start->end across polygons; true if a wall stops the walk. */
+    bool raycast(uint32_t startPoly, const glm::vec3& startPos, const glm::vec3& endPos,
+        NavRayHit& hit) const;
+
+    bool findNearestPoly(const glm::vec3& pos, const glm::vec3& extents,
+        uint32_t& poly, glm::vec3& nearest) const;
+
+private:
+    struct Node {
+        float g, f; // cost so far, g + heuristic
+        glm::vec3 pos; // where the path enters the polygon
+        uint32_t parent;
+        uint32_t stamp; // == m_stamp when valid for the current search
+        uint8_t closed;
+        uint32_t heapIndex;
+    };
+
+    Node& node(uint32_t p);
+    bool canWalk(const std::vector<uint32_t>& corridor, std::size_t portal, const glm::vec3& from,
+        const glm::vec3& to) const;
+    void heapPush(uint32_t p);
+    uint32_t heapPop();
+    void heapUp(uint32_t i);
+    void heapDown(uint32_t i);
+
+    const NavMesh* m_mesh;
+    std::vector<Node> m_nodes; // one per polygon
+    std::vector<uint32_t> m_heap; // open list, min-f binary heap
+    std::vector<glm::vec3> m_portalLeft, m_portalRight; // funnel scratch
+    std::vector<std::size_t> m_pointPortals; // portal each corner lies on
+    uint32_t m_stamp { 0 };
+
+    NavStatus m_status { NavStatus::Failed };
+    uint32_t m_startPoly { 0 }, m_endPoly { 0 };
+    glm::vec3 m_endPos { 0.f };
+    uint32_t m_bestPoly { 0 }; // lowest heuristic so far, for partial paths
+    float m_bestH { 0.f };
+};
@@ -0,0 +1,218 @@
+// source/nav/NavSystem.cpp
+#include "nav/NavSystem.hpp"
+#include "core/JobSystem.hpp"
+#include "nav/NavAgent.hpp"
+#include "nav/NavMesh.hpp"
+
+#include <algorithm>
+
+NavSystem::NavSystem(JobSystem* jobs, const NavSystemSettings& settings)
+    : m_jobs(jobs)
+    , m_settings(settings)
+    , m_slots(jobs ? std::size_t(jobs->workerCount()) + 1 : 1)
+{
+}
+
+NavSystem::~NavSystem() = default;
+
+void NavSystem::setNavMesh(const NavMesh* mesh)
+{
+    m_mesh = mesh;
+    for (Slot& slot : m_slots) {
+        slot.query.setMesh(mesh);
+        slot.busy = false;
+    }
+    m_mainQuery.setMesh(mesh);
+    m_pending.clear();
+    m_pendingHead = 0;
+    m_cache.clear();
+    m_cacheIndex.clear();
+}
+
+void NavSystem::add(NavAgent* agent)
+{
+    m_agents.push_back(agent);
+}
+
+void NavSystem::remove(NavAgent* agent)
+{
+    auto it = std::find(m_agents.begin(), m_agents.end(), agent);
+    if (it != m_agents.end()) {
+        *it = m_agents.back();
+        m_agents.pop_back();
+    }
+    // queued work stays queued, it just has nobody to report to
+    for (Request& r : m_incoming)
+        if (r.agent == agent)
+            r.agent = nullptr;
+    for (Request& r : m_pending)
+        if (r.agent == agent)
+            r.agent = nullptr;
+    for (Slot& slot : m_slots)
+        if (slot.req.agent == agent)
+            slot.req.agent = nullptr;
+}
+
+void NavSystem::request(NavAgent* agent, const glm::vec3& start, const glm::vec3& goal)
+{
+    m_incoming.push_back({ agent, agent->m_serial, start, goal, 0, 0 });
+}
+
+std::size_t NavSystem::pendingCount() const
+{
+    std::size_t n = m_incoming.size() + (m_pending.size() - m_pendingHead);
+    for (const Slot& slot : m_slots)
+        n += slot.busy ? 1 : 0;
+    return n;
+}
+
+void NavSystem::deliver(const Request& req, NavStatus status, const std::vector<glm::vec3>& points)
+{
+    if (req.agent && req.agent->m_serial == req.serial)
+        req.agent->onPath(status, points);
+}
+
+/* -------------------------------- cache -------------------------------- */
+const std::vector<uint32_t>* NavSystem::cacheFind(uint64_t key)
+{
+    auto it = m_cacheIndex.find(key);
+    if (it == m_cacheIndex.end())
+        return nullptr;
+    CacheEntry& e = m_cache[it->second];
+    e.lastUse = m_frame;
+    return &e.corridor;
+}
+
+void NavSystem::cacheStore(uint64_t key, const std::vector<uint32_t>& corridor)
+{
+    if (m_settings.cacheCapacity == 0)
+        return;
+    auto it = m_cacheIndex.find(key);
+    if (it != m_cacheIndex.end()) {
+        m_cache[it->second].corridor = corridor;
+        m_cache[it->second].lastUse = m_frame;
+        return;
+    }
+    if (m_cache.size() < m_settings.cacheCapacity) {
+        m_cacheIndex.emplace(key, uint32_t(m_cache.size()));
+        m_cache.push_back({ key, corridor, m_frame });
+        return;
+    }
+    // evict the least recently used; the table is small and stores are
+    // rare next to lookups
+    auto victim = std::min_element(m_cache.begin(), m_cache.end(),
+        [](const CacheEntry& a, const CacheEntry& b) { return a.lastUse < b.lastUse; });
+    m_cacheIndex.erase(victim->key);
+    m_cacheIndex.emplace(key, uint32_t(victim - m_cache.begin()));
+    victim->key = key;
+    victim->corridor = corridor;
+    victim->lastUse = m_frame;
+}
+
+/* ------------------------------- update -------------------------------- */
+void NavSystem::runSlot(std::size_t s, int budget)
+{
+    Slot& slot = m_slots[s];
+    while (budget > 0) {
+        if (!slot.busy) {
+            std::size_t i = m_claim.fetch_add(1, std::memory_order_relaxed);
+            if (i >= m_pending.size())
+                return;
+            slot.req = m_pending[i];
+            if (!slot.req.agent)
+                continue;
+            slot.busy = true;
+            slot.query.beginPath(slot.req.startPoly, slot.req.goalPoly, slot.req.start, slot.req.goal);
+        }
+
+        int done = 0;
+        NavStatus status = slot.query.updatePath(budget, &done);
+        budget -= std::max(done, 1);
+        if (status == NavStatus::InProgress)
+            continue;
+
+        Result& r = slot.done.emplace_back();
+        r.req = slot.req;
+        r.status = slot.query.finishPath(r.corridor);
+        slot.query.straightPath(r.corridor, slot.req.start, slot.req.goal, r.points);
+        slot.busy = false;
+    }
+}
+
+void NavSystem::update(float dt)
+{
+    ++m_frame;
+
+    if (m_mesh) {
+        // 1) snap new requests onto the mesh and try the corridor cache
+        for (Request& req : m_incoming) {
+            if (!req.agent)
+                continue;
+            glm::vec3 start, goal;
+            if (!m_mesh->findNearestPoly(req.start, m_settings.searchExtents, req.startPoly, start)
+                || !m_mesh->findNearestPoly(req.goal, m_settings.searchExtents, req.goalPoly, goal)) {
+                deliver(req, NavStatus::Failed, m_points);
+                continue;
+            }
+            req.start = start;
+            req.goal = goal;
+
+            const uint64_t key = (uint64_t(req.startPoly) << 32) | req.goalPoly;
+            if (const std::vector<uint32_t>* corridor = cacheFind(key)) {
+                ++m_cacheHits;
+                m_mainQuery.straightPath(*corridor, start, goal, m_points);
+                deliver(req, NavStatus::Success, m_points);
+            } else {
+                ++m_cacheMisses;
+                m_pending.push_back(req);
+            }
+        }
+        m_incoming.clear();
+
+        // 2) time-sliced searches, budget shared evenly between the slots
+        bool work = m_pendingHead < m_pending.size();
+        for (const Slot& slot : m_slots)
+            work |= slot.busy;
+        if (work) {
+            const int budget = std::max(1, m_settings.iterationsPerFrame / int(m_slots.size()));
+            m_claim.store(m_pendingHead, std::memory_order_relaxed);
+            if (m_jobs)
+                m_jobs->parallelFor(m_slots.size(), 1, [this, budget](std::size_t b, std::size_t e) {
+                    for (std::size_t s = b; s < e; ++s)
+                        runSlot(s, budget);
+                });
+            else
+                runSlot(0, budget);
+
+            m_pendingHead = std::min(m_claim.load(std::memory_order_relaxed), m_pending.size());
+            if (m_pendingHead == m_pending.size()) {
+                m_pending.clear();
+                m_pendingHead = 0;
+            }
+        }
+
+        // 3) hand results out on this thread
+        for (Slot& slot : m_slots) {
+            for (const Result& r : slot.done) {
+                if (r.status == NavStatus::Success)
+                    cacheStore((uint64_t(r.req.startPoly) << 32) | r.req.goalPoly, r.corridor);
+                deliver(r.req, r.status, r.points);
+            }
+            slot.done.clear();
+        }
+    } else {
+        for (const Request& req : m_incoming)
+            deliver(req, NavStatus::Failed, m_points);
+        m_incoming.clear();
+    }
+
+    // 4) steering; agents only touch their own Transform
+    auto advance = [this, dt](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i)
+            m_agents[i]->advance(dt);
+    };
+    if (m_jobs)
+        m_jobs->parallelFor(m_agents.size(), 64, advance);
+    else
+        advance(0, m_agents.size());
+}
@@ -0,0 +1,103 @@
+// source/nav/NavSystem.hpp
+#pragma once
+#include "nav/NavQuery.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+class NavAgent;
+class NavMesh;
+
+struct NavSystemSettings {
+    int iterationsPerFrame { 2048 }; // A* expansions per frame, all cores together
+    std::size_t cacheCapacity { 256 }; // corridors kept per start/goal polygon pair
+    glm::vec3 searchExtents { 1.f, 2.f, 1.f }; // snapping box for start and goal
+};
+
+/*
+ * Plans and follows paths for every registered NavAgent. Requests are
+ * snapped to the navmesh and checked against a cache of polygon
+ * corridors keyed by start/goal polygon; misses queue up and are searched
+ * with time-sliced A* on one NavQuery per core, so a crowd re-planning at
+ * once spreads over several frames instead of spiking one. Finished
+ * corridors are string-pulled on the worker that found them.
+ */
+class NavSystem {
+public:
+    explicit NavSystem(JobSystem* jobs = nullptr, const NavSystemSettings& settings = {});
+    ~NavSystem();
+
+    NavSystem(const NavSystem&) = delete;
+    NavSystem& operator=(const NavSystem&) = delete;
+
+    /* Drops queued requests and cached corridors. */
+    void setNavMesh(const NavMesh* mesh);
+    const NavMesh* navMesh() const { return m_mesh; }
+
+    void add(NavAgent* agent);
+    void remove(NavAgent* agent);
+
+    void update(float dt);
+
+    std::size_t agentCount() const { return m_agents.size(); }
+    std::size_t pendingCount() const;
+    std::size_t cacheHits() const { return m_cacheHits; }
+    std::size_t cacheMisses() const { return m_cacheMisses; }
+
+private:
+    friend class NavAgent;
+
+    struct Request {
+        NavAgent* agent; // nulled if the agent goes away while queued
+        uint32_t serial;
+        glm::vec3 start, goal;
+        uint32_t startPoly, goalPoly;
+    };
+    struct Result {
+        Request req;
+        NavStatus status;
+        std::vector<uint32_t> corridor;
+        std::vector<glm::vec3> points;
+    };
+    struct Slot {
+        NavQuery query;
+        Request req {};
+        bool busy { false };
+        std::vector<Result> done;
+    };
+    struct CacheEntry {
+        uint64_t key;
+        std::vector<uint32_t> corridor;
+        uint32_t lastUse;
+    };
+
+    void request(NavAgent* agent, const glm::vec3& start, const glm::vec3& goal);
+    void runSlot(std::size_t s, int budget);
+    void deliver(const Request& req, NavStatus status, const std::vector<glm::vec3>& points);
+
+    const std::vector<uint32_t>* cacheFind(uint64_t key);
+    void cacheStore(uint64_t key, const std::vector<uint32_t>& corridor);
+
+    JobSystem* m_jobs;
+    NavSystemSettings m_settings;
+    const NavMesh* m_mesh { nullptr };
+    std::vector<NavAgent*> m_agents;
+
+    std::vector<Request> m_incoming; // this frame's requests, not yet snapped
+    std::vector<Request> m_pending; // cache misses waiting for a slot
+    std::size_t m_pendingHead { 0 };
+    std::atomic<std::size_t> m_claim { 0 }; // next m_pending entry for a slot
+
+    std::vector<Slot> m_slots; // one search in flight per core
+    NavQuery m_mainQuery; // string-pulling for cache hits
+    std::vector<glm::vec3> m_points;
+
+    std::vector<CacheEntry> m_cache;
+    std::unordered_map<uint64_t, uint32_t> m_cacheIndex;
+    uint32_t m_frame { 0 };
+    std::size_t m_cacheHits { 0 }, m_cacheMisses { 0 };
+};
@@ -0,0 +1,154 @@
+// source/nav/test/NavQueryTest.cpp
+//
+// Path shape checks for NavQuery: bake small levels on the host, string-pull
+// paths across them and compare the corners against what a taut path must
+// look like. Needs glm on the include path.
+//
+//   g++ -std=c++17 -Isource source/nav/test/NavQueryTest.cpp source/nav/NavMesh.cpp
+//       source/nav/NavMeshBuilder.cpp source/nav/NavQuery.cpp source/geom/TriMesh.cpp
+//       source/geom/MeshBvh.cpp source/geom/Intersect.cpp source/geom/StaticMesh.cpp
+//       source/core/GameObject.cpp source/core/Component.cpp source/core/Transform.cpp
+//       -o navtest && ./navtest
+#include "geom/TriMesh.hpp"
+#include "nav/NavMesh.hpp"
+#include "nav/NavMeshBuilder.hpp"
+#include "nav/NavQuery.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static int s_failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    std::printf("%s: %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok)
+        ++s_failures;
+}
+
+/* ------------------------------- levels -------------------------------- */
+
+// 20x20 floor centred on the origin, optionally with a 2x2 pillar in the middle
+static bool bakeLevel(bool pillar, NavMesh& out)
+{
+    std::vector<glm::vec3> v = { { -10.f, 0.f, -10.f }, { 10.f, 0.f, -10.f }, { 10.f, 0.f, 10.f },
+        { -10.f, 0.f, 10.f } };
+    std::vector<uint32_t> idx = { 0, 2, 1, 0, 3, 2 };
+    if (pillar) {
+        for (int i = 0; i < 8; ++i)
+            v.push_back(glm::vec3(i & 1 ? 1.f : -1.f, i & 2 ? 3.f : 0.f, i & 4 ? 1.f : -1.f));
+        // outward-facing, counter-clockwise
+        const uint32_t box[36] = { 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2,
+            1, 3, 7, 1, 7, 5, 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6 };
+        for (uint32_t i : box)
+            idx.push_back(4 + i);
+    }
+    TriMesh mesh;
+    mesh.setData(std::move(v), std::move(idx));
+
+    NavBuildSettings settings;
+    settings.maxPolyCells = 8; // many small polygons, so corridors can staircase
+    NavMeshBuilder builder(settings);
+    builder.addMesh(mesh, glm::mat4(1.f));
+    return builder.build(out);
+}
+
+static bool plan(NavQuery& query, const glm::vec3& from, const glm::vec3& to, std::vector<glm::vec3>& points)
+{
+    const glm::vec3 ext(1.f, 2.f, 1.f);
+    uint32_t a, b;
+    glm::vec3 pa, pb;
+    std::vector<uint32_t> corridor;
+    if (!query.findNearestPoly(from, ext, a, pa) || !query.findNearestPoly(to, ext, b, pb)
+        || query.findPath(a, b, pa, pb, corridor) != NavStatus::Success)
+        return false;
+    query.straightPath(corridor, pa, pb, points);
+    return true;
+}
+
+static bool nearXZ(const glm::vec3& a, const glm::vec3& b, float tolerance)
+{
+    return std::hypot(a.x - b.x, a.z - b.z) <= tolerance;
+}
+
+/* -------------------------------- tests -------------------------------- */
+
+// Nothing in the way: exactly the two end points, however the corridor runs.
+static void testVisible(NavQuery& query, const glm::vec3& from, const glm::vec3& to)
+{
+    std::vector<glm::vec3> points;
+    const bool found = plan(query, from, to, points);
+    char what[128];
+    std::snprintf(what, sizeof(what), "(%g,%g) -> (%g,%g) is a straight line", from.x, from.z, to.x, to.z);
+    check(found && points.size() == 2 && nearXZ(points[0], from, 1e-3f) && nearXZ(points[1], to, 1e-3f), what);
+}
+
+// Around the pillar: bends only at the pillar corners passed, in order, and
+// at each of them. Erosion can round one pillar corner into a short chain
+// of navmesh corners, each of which the taut path bends at.
+static void testPillar(NavQuery& query, const glm::vec3& from, const glm::vec3& to,
+    const std::vector<glm::vec3>& corners)
+{
+    std::vector<glm::vec3> points;
+    bool ok = plan(query, from, to, points) && points.size() >= corners.size() + 2;
+    std::size_t at = 0, bends = 0; // pillar corner being passed, bends seen there
+    for (std::size_t i = 1; ok && i + 1 < points.size(); ++i) {
+        if (bends > 0 && at + 1 < corners.size() && nearXZ(points[i], corners[at + 1], 1.f)) {
+            ++at;
+            bends = 0;
+        }
+        ok = nearXZ(points[i], corners[at], 1.f);
+        ++bends;
+    }
+    ok = ok && at + 1 == corners.size() && bends > 0;
+    char what[128];
+    std::snprintf(what, sizeof(what), "(%g,%g) -> (%g,%g) bends at %zu pillar corner(s)", from.x, from.z, to.x,
+        to.z, corners.size());
+    check(ok, what);
+}
+
+// Into the pillar's side: stops at the wall with the normal facing back.
+static void testRaycast(NavQuery& query, const glm::vec3& from, const glm::vec3& to, const glm::vec3& normal)
+{
+    const glm::vec3 ext(1.f, 2.f, 1.f);
+    uint32_t poly;
+    glm::vec3 start;
+    NavRayHit hit;
+    const bool ok = query.findNearestPoly(from, ext, poly, start) && query.raycast(poly, start, to, hit)
+        && hit.t > 0.f && hit.t < 1.f && glm::dot(hit.normal, normal) > 0.99f
+        && glm::dot(hit.normal, to - from) < 0.f;
+    char what[128];
+    std::snprintf(what, sizeof(what), "raycast (%g,%g) -> (%g,%g) hits a wall facing (%g,%g)", from.x, from.z,
+        to.x, to.z, normal.x, normal.z);
+    check(ok, what);
+}
+
+int main()
+{
+    NavMesh floor, pillar;
+    if (!bakeLevel(false, floor) || !bakeLevel(true, pillar)) {
+        std::printf("FAIL: bake\n");
+        return EXIT_FAILURE;
+    }
+
+    NavQuery query(&floor);
+    testVisible(query, { -8.f, 0.f, -8.f }, { 8.f, 0.f, 8.f }); // through polygon corners
+    testVisible(query, { -9.f, 0.f, 0.f }, { 9.f, 0.f, 0.f }); // along polygon edges
+    testVisible(query, { -7.3f, 0.f, 8.1f }, { 6.9f, 0.f, -5.2f });
+    testVisible(query, { 2.f, 0.f, -9.f }, { 2.5f, 0.f, 9.f });
+
+    query.setMesh(&pillar);
+    testVisible(query, { -8.f, 0.f, -6.f }, { 8.f, 0.f, -5.f }); // passes the pillar by
+    testPillar(query, { -6.f, 0.f, -0.5f }, { 6.f, 0.f, -0.5f }, { { -1.f, 0.f, -1.f }, { 1.f, 0.f, -1.f } });
+    testPillar(query, { 0.f, 0.f, -6.f }, { 0.3f, 0.f, 6.f }, { { -1.f, 0.f, -1.f }, { -1.f, 0.f, 1.f } });
+    testPillar(query, { 0.f, 0.f, -2.f }, { -2.f, 0.f, 0.f }, { { -1.f, 0.f, -1.f } });
+    testPillar(query, { 2.f, 0.f, 0.f }, { 0.f, 0.f, 2.f }, { { 1.f, 0.f, 1.f } });
+    testPillar(query, { 0.f, 0.f, 2.f }, { -2.f, 0.f, 0.f }, { { -1.f, 0.f, 1.f } });
+    testRaycast(query, { -6.f, 0.f, 0.f }, { 0.f, 0.f, 0.f }, { -1.f, 0.f, 0.f });
+    testRaycast(query, { 0.3f, 0.f, 6.f }, { 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f });
+
+    std::printf("%d failure(s)\n", s_failures);
+    return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+// tools/raybench/main.cpp
+//
+// Host-side MeshBvh benchmark: build cost and rays per second for single
+// rays, 4-ray packets and packets spread over threads, plus sphere
+// overlaps. Uses the same source/geom code as the console build; on x86
+// the BVH's lane math compiles to SSE instead of NEON.
+//
+//   raybench [mesh.stl ...]   (default: assets/STLs/basic/icosphere.stl)
+#include "geom/MeshBvh.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kImage = 512; // camera rays per side
+constexpr int kRandomRays = 256 * 1024;
+constexpr int kOverlaps = 16 * 1024;
+
+struct Mesh {
+    std::string name;
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+    glm::vec3 bmin { 0.f }, bmax { 0.f };
+
+    void updateBounds()
+    {
+        bmin = bmax = vertices.empty() ? glm::vec3(0.f) : vertices[0];
+        for (const glm::vec3& v : vertices) {
+            bmin = glm::min(bmin, v);
+            bmax = glm::max(bmax, v);
+        }
+    }
+};
+
+struct Rng {
+    uint32_t s = 0x2545F491u;
+    float next01()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return float(s >> 8) * (1.f / 16777216.f);
+    }
+    float range(float lo, float hi) { return lo + (hi - lo) * next01(); }
+};
+
+double nowSec()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Binary STL only, corners left unwelded; the BVH does not care.
+bool loadStl(const char* path, Mesh& out)
+{
+    FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<uint8_t> d;
+    uint8_t buf[4096];
+    for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;)
+        d.insert(d.end(), buf, buf + n);
+    std::fclose(f);
+    if (d.size() < 84)
+        return false;
+    uint32_t tris;
+    std::memcpy(&tris, &d[80], 4);
+    if (d.size() != 84 + std::size_t(tris) * 50)
+        return false; // ASCII or truncated
+
+    out.name = path;
+    for (uint32_t t = 0; t < tris; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            float p[3];
+            std::memcpy(p, &d[84 + t * 50 + 12 + k * 12], sizeof(p));
+            out.indices.push_back(uint32_t(out.vertices.size()));
+            out.vertices.push_back(glm::vec3(p[0], p[1], p[2]));
+        }
+    }
+    out.updateBounds();
+    return true;
+}
+
+// rolling hills, two triangles per cell
+Mesh makeTerrain(int cells, float size)
+{
+    Mesh m;
+    m.name = "terrain";
+    const float step = size / cells;
+    for (int z = 0; z <= cells; ++z)
+        for (int x = 0; x <= cells; ++x)
+            m.vertices.push_back(glm::vec3(x * step, 4.f * std::sin(x * 0.11f) * std::cos(z * 0.07f), z * step));
+    const uint32_t row = uint32_t(cells + 1);
+    for (int z = 0; z < cells; ++z) {
+        for (int x = 0; x < cells; ++x) {
+            const uint32_t i = uint32_t(z) * row + uint32_t(x);
+            m.indices.insert(m.indices.end(), { i, i + row, i + 1, i + 1, i + row, i + row + 1 });
+        }
+    }
+    m.updateBounds();
+    return m;
+}
+
+struct Camera {
+    glm::vec3 eye, forward, right, up;
+
+    explicit Camera(const Mesh& mesh)
+    {
+        const glm::vec3 center = (mesh.bmin + mesh.bmax) * 0.5f;
+        const float radius = glm::length(mesh.bmax - mesh.bmin) * 0.5f;
+        eye = center + glm::vec3(0.3f, 0.8f, -1.f) * radius * 1.4f;
+        forward = glm::normalize(center - eye);
+        right = glm::normalize(glm::cross(forward, glm::vec3(0.f, 1.f, 0.f)));
+        up = glm::cross(right, forward);
+    }
+    Ray ray(int x, int y) const
+    {
+        const float u = (x + 0.5f) / kImage * 2.f - 1.f;
+        const float v = (y + 0.5f) / kImage * 2.f - 1.f;
+        Ray r;
+        r.origin = eye;
+        r.dir = glm::normalize(forward + right * (u * 0.6f) + up * (v * 0.6f));
+        return r;
+    }
+};
+
+// rows [first, last) as 2x2 pixel packets
+std::size_t tracePackets(const MeshBvh& bvh, const Camera& cam, int first, int last)
+{
+    std::size_t hits = 0;
+    for (int y = first; y < last; y += 2) {
+        for (int x = 0; x < kImage; x += 2) {
+            RayPacket p;
+            for (int i = 0; i < 4; ++i)
+                p.set(i, cam.ray(x + (i & 1), y + (i >> 1)));
+            PacketHit h;
+            hits += std::size_t(__builtin_popcount(bvh.raycast(p, h)));
+        }
+    }
+    return hits;
+}
+
+double mrays(std::size_t rays, double sec) { return double(rays) / sec / 1e6; }
+
+void bench(const Mesh& mesh, unsigned threads)
+{
+    MeshBvh bvh;
+    double t0 = nowSec();
+    bvh.build(mesh.vertices, mesh.indices);
+    std::printf("%s: %zu tris, %zu nodes (%zu KB), built in %.2f ms\n", mesh.name.c_str(),
+        mesh.indices.size() / 3, bvh.nodeCount(), bvh.memoryUsage() / 1024, (nowSec() - t0) * 1e3);
+
+    const Camera cam(mesh);
+    const std::size_t pixels = std::size_t(kImage) * kImage;
+
+    std::size_t hits = 0;
+    t0 = nowSec();
+    for (int y = 0; y < kImage; ++y)
+        for (int x = 0; x < kImage; ++x) {
+            RayHit h;
+            hits += bvh.raycast(cam.ray(x, y), h) ? 1 : 0;
+        }
+    const double single = nowSec() - t0;
+
+    t0 = nowSec();
+    const std::size_t packetHits = tracePackets(bvh, cam, 0, kImage);
+    const double packet = nowSec() - t0;
+
+    std::atomic<std::size_t> threadHits { 0 };
+    std::atomic<int> nextRow { 0 };
+    t0 = nowSec();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i)
+        pool.emplace_back([&]() {
+            for (int y; (y = nextRow.fetch_add(16)) < kImage;)
+                threadHits += tracePackets(bvh, cam, y, std::min(y + 16, kImage));
+        });
+    for (std::thread& t : pool)
+        t.join();
+    const double parallel = nowSec() - t0;
+
+    std::printf("  camera   %7.2f Mrays/s single, %7.2f packet, %7.2f packet x%u threads (%zu/%zu/%zu hits)\n",
+        mrays(pixels, single), mrays(pixels, packet), mrays(pixels, parallel), threads, hits, packetHits,
+        threadHits.load());
+
+    Rng rng;
+    const glm::vec3 lo = mesh.bmin, hi = mesh.bmax;
+    std::vector<Ray> rays(kRandomRays);
+    for (Ray& r : rays) {
+        r.origin = glm::vec3(rng.range(lo.x, hi.x), rng.range(lo.y, hi.y) + (hi.y - lo.y), rng.range(lo.z, hi.z));
+        r.dir = glm::normalize(glm::vec3(rng.range(-1.f, 1.f), rng.range(-1.f, 0.f), rng.range(-1.f, 1.f)));
+    }
+    hits = 0;
+    t0 = nowSec();
+    for (const Ray& r : rays) {
+        RayHit h;
+        hits += bvh.raycast(r, h) ? 1 : 0;
+    }
+    const double closest = nowSec() - t0;
+    std::size_t blocked = 0;
+    t0 = nowSec();
+    for (const Ray& r : rays)
+        blocked += bvh.occluded(r) ? 1 : 0;
+    const double any = nowSec() - t0;
+    std::printf("  random   %7.2f Mrays/s closest hit, %7.2f any hit (%zu/%zu hits)\n",
+        mrays(rays.size(), closest), mrays(rays.size(), any), hits, blocked);
+
+    const float radius = glm::length(hi - lo) * 0.05f;
+    std::vector<uint32_t> tris;
+    std::size_t found = 0;
+    t0 = nowSec();
+    for (int i = 0; i < kOverlaps; ++i) {
+        tris.clear();
+        bvh.overlapSphere(glm::vec3(rng.range(lo.x, hi.x), rng.range(lo.y, hi.y), rng.range(lo.z, hi.z)),
+            radius, tris);
+        found += tris.size();
+    }
+    std::printf("  overlap  %7.2f us/sphere query (%.1f tris avg)\n", (nowSec() - t0) * 1e6 / kOverlaps,
+        double(found) / kOverlaps);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<const char*> paths(argv + 1, argv + argc);
+    if (paths.empty())
+        paths.push_back("assets/STLs/basic/icosphere.stl");
+
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (const char* path : paths) {
+        Mesh mesh;
+        if (!loadStl(path, mesh)) {
+            std::fprintf(stderr, "raybench: cannot load binary STL %s\n", path);
+            return 1;
+        }
+        bench(mesh, threads);
+    }
+    bench(makeTerrain(256, 128.f), threads);
+    return 0;
+}
@@ -0,0 +1,91 @@
+// tools/texcook/Atlas.cpp
+#include "Atlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+static int alignUp(int v, int a) { return (v + a - 1) / a * a; }
+
+struct Placement {
+    int x, y; // top-left of the padded cell
+};
+
+// Try to shelf-pack every padded cell into a w x h sheet.
+static bool tryPack(const std::vector<AtlasInput>& inputs,
+    const std::vector<size_t>& order, int padding, int w, int h,
+    std::vector<Placement>& out)
+{
+    out.assign(inputs.size(), {});
+    int shelfX = 0, shelfY = 0, shelfH = 0;
+    for (size_t i : order) {
+        int cw = alignUp(inputs[i].image.width + 2 * padding, 4);
+        int ch = alignUp(inputs[i].image.height + 2 * padding, 4);
+        if (cw > w)
+            return false;
+        if (shelfX + cw > w) {
+            shelfY += shelfH;
+            shelfX = 0;
+            shelfH = 0;
+        }
+        if (shelfY + ch > h)
+            return false;
+        out[i] = { shelfX, shelfY };
+        shelfX += cw;
+        shelfH = std::max(shelfH, ch);
+    }
+    return true;
+}
+
+bool packAtlas(const std::vector<AtlasInput>& inputs, int padding, int maxSize,
+    Atlas& out, std::string* error)
+{
+    std::vector<size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return inputs[a].image.height > inputs[b].image.height;
+    });
+
+    // grow alternately in width and height until everything fits
+    std::vector<Placement> place;
+    int w = 64, h = 64;
+    while (!tryPack(inputs, order, padding, w, h, place)) {
+        if (w > h)
+            h *= 2;
+        else
+            w *= 2;
+        if (w > maxSize || h > maxSize) {
+            *error = "inputs do not fit in a " + std::to_string(maxSize) + " atlas";
+            return false;
+        }
+    }
+
+    out.image.width = w;
+    out.image.height = h;
+    out.image.rgba.assign(size_t(w) * h * 4, 0);
+    out.regions.resize(inputs.size());
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Image& src = inputs[i].image;
+        int ox = place[i].x + padding, oy = place[i].y + padding;
+
+        // copy with the border extruded into the gutter
+        for (int y = -padding; y < src.height + padding; ++y)
+            for (int x = -padding; x < src.width + padding; ++x) {
+                int sx = std::clamp(x, 0, src.width - 1);
+                int sy = std::clamp(y, 0, src.height - 1);
+                std::memcpy(out.image.pixel(ox + x, oy + y), src.pixel(sx, sy), 4);
+            }
+
+        TexAtlasRegion& r = out.regions[i];
+        std::memset(&r, 0, sizeof(r));
+        std::strncpy(r.name, inputs[i].name.c_str(), sizeof(r.name) - 1);
+        r.u0 = float(ox) / w;
+        r.v0 = float(oy) / h;
+        r.u1 = float(ox + src.width) / w;
+        r.v1 = float(oy + src.height) / h;
+        r.width = uint16_t(src.width);
+        r.height = uint16_t(src.height);
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+// tools/texcook/Atlas.hpp
+#pragma once
+#include "Image.hpp"
+#include "graphics/TextureFormat.hpp"
+#include <string>
+#include <vector>
+
+struct AtlasInput {
+    std::string name; // becomes TexAtlasRegion::name
+    Image image;
+};
+
+struct Atlas {
+    Image image;
+    std::vector<TexAtlasRegion> regions; // same order as the inputs
+};
+
+/*
+ * Shelf-packs the inputs (tallest first) into the smallest power-of-two
+ * square-ish atlas that fits, up to maxSize. Every image gets `padding`
+ * texels of gutter on each side filled by extruding its border, so
+ * bilinear filtering and the first log2(padding) mips do not bleed
+ * between neighbours. Placements are 4-texel aligned, so no mip 0
+ * block straddles two images. That does not hold further down: a block
+ * at level n covers 4 << n base texels and can mix neighbours, so only
+ * the gutter keeps their colours apart there.
+ */
+bool packAtlas(const std::vector<AtlasInput>& inputs, int padding, int maxSize,
+    Atlas& out, std::string* error);
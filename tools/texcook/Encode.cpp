@@ -0,0 +1,428 @@
+// tools/texcook/Encode.cpp
+#include "Encode.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/* ---------------------------- shared helpers --------------------------- */
+
+// Principal axis of the block's colours over the first `channels`
+// components, with its mean. Power iteration is plenty for 16 samples.
+// Returns false when there is no usable axis (flat block, or the
+// iteration collapsed numerically).
+static bool principalAxis(const uint8_t px[16][4], int channels,
+    float mean[4], float axis[4])
+{
+    for (int c = 0; c < 4; ++c)
+        mean[c] = axis[c] = 0.f;
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < channels; ++c)
+            mean[c] += px[i][c] / 16.f;
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+        for (int a = 0; a < channels; ++a)
+            for (int b = 0; b < channels; ++b)
+                cov[a][b] += (px[i][a] - mean[a]) * (px[i][b] - mean[b]);
+
+    // Start from the covariance row of the widest channel. A fixed start
+    // such as (1,1,1,1) is orthogonal to red<->green or blue<->yellow
+    // variation and would collapse those blocks to their mean.
+    int widest = 0;
+    for (int c = 1; c < channels; ++c)
+        if (cov[c][c] > cov[widest][widest])
+            widest = c;
+
+    float v[4] = {};
+    for (int c = 0; c < channels; ++c)
+        v[c] = cov[widest][c];
+    for (int iter = 0; iter < 8; ++iter) {
+        float len = 0.f;
+        for (int c = 0; c < channels; ++c)
+            len += v[c] * v[c];
+        if (len < 1e-12f)
+            return false;
+        len = 1.f / std::sqrt(len);
+        for (int c = 0; c < channels; ++c)
+            v[c] *= len;
+
+        float n[4] = {};
+        for (int a = 0; a < channels; ++a)
+            for (int b = 0; b < channels; ++b)
+                n[a] += cov[a][b] * v[b];
+        for (int c = 0; c < channels; ++c)
+            v[c] = n[c];
+    }
+
+    float len = 0.f;
+    for (int c = 0; c < channels; ++c)
+        len += v[c] * v[c];
+    if (len < 1e-12f)
+        return false;
+    len = 1.f / std::sqrt(len);
+    for (int c = 0; c < channels; ++c)
+        axis[c] = v[c] * len;
+    return true;
+}
+
+// Project onto the principal axis and return the extreme points. Without
+// an axis, fall back to the per-channel bounding box.
+static void axisEndpoints(const uint8_t px[16][4], int channels,
+    float lo[4], float hi[4])
+{
+    float mean[4], axis[4];
+    if (!principalAxis(px, channels, mean, axis)) {
+        for (int c = 0; c < 4; ++c) {
+            lo[c] = 255.f;
+            hi[c] = 0.f;
+            for (int i = 0; i < 16; ++i) {
+                lo[c] = std::min(lo[c], float(px[i][c]));
+                hi[c] = std::max(hi[c], float(px[i][c]));
+            }
+            if (c >= channels)
+                lo[c] = hi[c] = mean[c];
+        }
+        return;
+    }
+    float tMin = std::numeric_limits<float>::max();
+    float tMax = -tMin;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.f;
+        for (int c = 0; c < channels; ++c)
+            t += (px[i][c] - mean[c]) * axis[c];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    for (int c = 0; c < 4; ++c) {
+        lo[c] = std::clamp(mean[c] + tMin * axis[c], 0.f, 255.f);
+        hi[c] = std::clamp(mean[c] + tMax * axis[c], 0.f, 255.f);
+    }
+}
+
+static int colorDist(const uint8_t* a, const int* b, int channels)
+{
+    int d = 0;
+    for (int c = 0; c < channels; ++c)
+        d += (a[c] - b[c]) * (a[c] - b[c]);
+    return d;
+}
+
+/* --------------------------------- BC1 --------------------------------- */
+
+static uint16_t to565(const float c[3])
+{
+    int r = int(c[0] * 31.f / 255.f + 0.5f);
+    int g = int(c[1] * 63.f / 255.f + 0.5f);
+    int b = int(c[2] * 31.f / 255.f + 0.5f);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+static void from565(uint16_t v, int out[3])
+{
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+void encodeBC1(const uint8_t px[16][4], uint8_t out[8])
+{
+    float lo[4], hi[4];
+    axisEndpoints(px, 3, lo, hi);
+    uint16_t c0 = to565(hi), c1 = to565(lo);
+    if (c0 < c1)
+        std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        // four-colour mode (c0 > c1): c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+        int pal[4][3];
+        from565(c0, pal[0]);
+        from565(c1, pal[1]);
+        for (int c = 0; c < 3; ++c) {
+            pal[2][c] = (2 * pal[0][c] + pal[1][c]) / 3;
+            pal[3][c] = (pal[0][c] + 2 * pal[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = std::numeric_limits<int>::max();
+            for (int k = 0; k < 4; ++k) {
+                int err = colorDist(px[i], pal[k], 3);
+                if (err < bestErr) {
+                    bestErr = err;
+                    best = k;
+                }
+            }
+            indices |= uint32_t(best) << (2 * i);
+        }
+    }
+
+    out[0] = uint8_t(c0);
+    out[1] = uint8_t(c0 >> 8);
+    out[2] = uint8_t(c1);
+    out[3] = uint8_t(c1 >> 8);
+    for (int b = 0; b < 4; ++b)
+        out[4 + b] = uint8_t(indices >> (8 * b));
+}
+
+/* --------------------------------- BC3 --------------------------------- */
+
+void encodeBC3(const uint8_t px[16][4], uint8_t out[16])
+{
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max<int>(a0, px[i][3]);
+        a1 = std::min<int>(a1, px[i][3]);
+    }
+
+    uint64_t bits = 0;
+    if (a0 != a1) {
+        // eight-value mode (a0 > a1): a0, a1, then six interpolants
+        int pal[8] = { a0, a1 };
+        for (int k = 2; k < 8; ++k)
+            pal[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = 256;
+            for (int k = 0; k < 8; ++k) {
+                int err = std::abs(px[i][3] - pal[k]);
+                if (err < bestErr) {
+                    bestErr = err;
+                    best = k;
+                }
+            }
+            bits |= uint64_t(best) << (3 * i);
+        }
+    }
+
+    out[0] = uint8_t(a0);
+    out[1] = uint8_t(a1);
+    for (int b = 0; b < 6; ++b)
+        out[2 + b] = uint8_t(bits >> (8 * b));
+    encodeBC1(px, out + 8);
+}
+
+/* --------------------------------- ETC1 -------------------------------- */
+
+static const int kEtcModifiers[8][4] = {
+    { 2, 8, -2, -8 },
+    { 5, 17, -5, -17 },
+    { 9, 29, -9, -29 },
+    { 13, 42, -13, -42 },
+    { 18, 60, -18, -60 },
+    { 24, 80, -24, -80 },
+    { 33, 106, -33, -106 },
+    { 47, 183, -47, -183 },
+};
+
+struct EtcSubblock {
+    int table;
+    int error;
+    uint8_t index[8]; // 0..3 -> +a, +b, -a, -b
+};
+
+// Best modifier table and per-texel indices for one half-block.
+static EtcSubblock fitSubblock(const uint8_t* texels[8], const int base[3])
+{
+    EtcSubblock best {};
+    best.error = std::numeric_limits<int>::max();
+    for (int t = 0; t < 8; ++t) {
+        EtcSubblock cand {};
+        cand.table = t;
+        for (int i = 0; i < 8; ++i) {
+            int bestErr = std::numeric_limits<int>::max();
+            for (int k = 0; k < 4; ++k) {
+                int col[3];
+                for (int c = 0; c < 3; ++c)
+                    col[c] = std::clamp(base[c] + kEtcModifiers[t][k], 0, 255);
+                int err = colorDist(texels[i], col, 3);
+                if (err < bestErr) {
+                    bestErr = err;
+                    cand.index[i] = uint8_t(k);
+                }
+            }
+            cand.error += bestErr;
+        }
+        if (cand.error < best.error)
+            best = cand;
+    }
+    return best;
+}
+
+void encodeETC1(const uint8_t px[16][4], uint8_t out[8])
+{
+    uint64_t bestBlock = 0;
+    int bestError = std::numeric_limits<int>::max();
+
+    for (int flip = 0; flip < 2; ++flip) {
+        // half-blocks: 2x4 side by side, or 4x2 stacked when flipped
+        const uint8_t* texels[2][8];
+        int pos[2][8];
+        int n[2] = {};
+        for (int y = 0; y < 4; ++y)
+            for (int x = 0; x < 4; ++x) {
+                int s = flip ? (y >= 2) : (x >= 2);
+                texels[s][n[s]] = px[y * 4 + x];
+                pos[s][n[s]++] = x * 4 + y; // ETC indexes texels column-major
+            }
+
+        float avg[2][3] = {};
+        for (int s = 0; s < 2; ++s)
+            for (int i = 0; i < 8; ++i)
+                for (int c = 0; c < 3; ++c)
+                    avg[s][c] += texels[s][i][c] / 8.f;
+
+        // differential mode (5-bit base + 3-bit delta) when the halves are
+        // close enough, otherwise individual mode (two 4-bit bases)
+        int q5[2][3], q4[2][3];
+        bool diff = true;
+        for (int c = 0; c < 3; ++c) {
+            for (int s = 0; s < 2; ++s) {
+                q5[s][c] = int(avg[s][c] * 31.f / 255.f + 0.5f);
+                q4[s][c] = int(avg[s][c] * 15.f / 255.f + 0.5f);
+            }
+            int d = q5[1][c] - q5[0][c];
+            diff = diff && d >= -4 && d <= 3;
+        }
+
+        int base[2][3];
+        for (int s = 0; s < 2; ++s)
+            for (int c = 0; c < 3; ++c)
+                base[s][c] = diff ? (q5[s][c] << 3) | (q5[s][c] >> 2) : q4[s][c] * 17;
+
+        EtcSubblock sub[2] = { fitSubblock(texels[0], base[0]),
+            fitSubblock(texels[1], base[1]) };
+        int error = sub[0].error + sub[1].error;
+        if (error >= bestError)
+            continue;
+        bestError = error;
+
+        uint64_t block = 0;
+        for (int c = 0; c < 3; ++c) {
+            int shift = 59 - 8 * c; // R at 63..56, G at 55..48, B at 47..40
+            if (diff) {
+                int d = (q5[1][c] - q5[0][c]) & 7;
+                block |= uint64_t(q5[0][c]) << shift;
+                block |= uint64_t(d) << (shift - 3);
+            } else {
+                block |= uint64_t(q4[0][c]) << (shift + 1);
+                block |= uint64_t(q4[1][c]) << (shift - 3);
+            }
+        }
+        block |= uint64_t(sub[0].table) << 37;
+        block |= uint64_t(sub[1].table) << 34;
+        block |= uint64_t(diff) << 33;
+        block |= uint64_t(flip) << 32;
+        for (int s = 0; s < 2; ++s)
+            for (int i = 0; i < 8; ++i) {
+                int idx = sub[s].index[i];
+                block |= uint64_t(idx >> 1) << (16 + pos[s][i]);
+                block |= uint64_t(idx & 1) << pos[s][i];
+            }
+        bestBlock = block;
+    }
+
+    for (int b = 0; b < 8; ++b)
+        out[b] = uint8_t(bestBlock >> (56 - 8 * b)); // big-endian
+}
+
+/* ------------------------------- ASTC 4x4 ------------------------------ */
+
+// Fixed configuration that needs no trit/quint coding:
+//   block mode 0x042: 4x4 weight grid, 2-bit weights (QUANT_4), one plane
+//   one partition, CEM 12 (LDR RGBA direct)
+//   8 endpoint values at 8 bits each (QUANT_256 is the largest range that
+//   fits the 79 remaining bits)
+static void setBits(uint8_t block[16], int pos, int count, uint32_t value)
+{
+    for (int i = 0; i < count; ++i)
+        if (value & (1u << i))
+            block[(pos + i) >> 3] |= uint8_t(1u << ((pos + i) & 7));
+}
+
+void encodeASTC4x4(const uint8_t px[16][4], uint8_t out[16])
+{
+    static const int kWeights[4] = { 0, 21, 43, 64 }; // unquantised QUANT_4
+
+    float lo[4], hi[4];
+    axisEndpoints(px, 4, lo, hi);
+    int e[2][4];
+    for (int c = 0; c < 4; ++c) {
+        e[0][c] = int(lo[c] + 0.5f);
+        e[1][c] = int(hi[c] + 0.5f);
+    }
+    // the decoder blue-contracts and swaps when e1 is darker than e0
+    if (e[1][0] + e[1][1] + e[1][2] < e[0][0] + e[0][1] + e[0][2])
+        std::swap(e[0], e[1]);
+
+    int pal[4][4];
+    for (int k = 0; k < 4; ++k)
+        for (int c = 0; c < 4; ++c) {
+            int c0 = e[0][c] * 257, c1 = e[1][c] * 257; // UNORM16 expansion
+            pal[k][c] = ((c0 * (64 - kWeights[k]) + c1 * kWeights[k] + 32) >> 6) >> 8;
+        }
+
+    std::memset(out, 0, 16);
+    setBits(out, 0, 11, 0x042); // block mode
+    setBits(out, 11, 2, 0); // partition count - 1
+    setBits(out, 13, 4, 12); // colour endpoint mode
+    for (int c = 0; c < 4; ++c) {
+        setBits(out, 17 + 16 * c, 8, uint32_t(e[0][c]));
+        setBits(out, 17 + 16 * c + 8, 8, uint32_t(e[1][c]));
+    }
+
+    // weights are stored bit-reversed from the top of the block
+    for (int i = 0; i < 16; ++i) {
+        int best = 0, bestErr = std::numeric_limits<int>::max();
+        for (int k = 0; k < 4; ++k) {
+            int err = colorDist(px[i], pal[k], 4);
+            if (err < bestErr) {
+                bestErr = err;
+                best = k;
+            }
+        }
+        setBits(out, 127 - 2 * i, 1, uint32_t(best & 1));
+        setBits(out, 126 - 2 * i, 1, uint32_t(best >> 1));
+    }
+}
+
+/* ------------------------------ whole level ---------------------------- */
+
+std::vector<uint8_t> encodeLevel(TexFormat format, const Image& img)
+{
+    if (format == TexFormat::RGBA8)
+        return img.rgba;
+
+    const uint32_t blockBytes = texBlockBytes(format);
+    const int bw = (img.width + 3) / 4, bh = (img.height + 3) / 4;
+    std::vector<uint8_t> out(size_t(bw) * bh * blockBytes);
+
+    uint8_t tile[16][4];
+    for (int by = 0; by < bh; ++by)
+        for (int bx = 0; bx < bw; ++bx) {
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(bx * 4 + x, img.width - 1);
+                    int sy = std::min(by * 4 + y, img.height - 1);
+                    std::memcpy(tile[y * 4 + x], img.pixel(sx, sy), 4);
+                }
+            uint8_t* dst = &out[(size_t(by) * bw + bx) * blockBytes];
+            switch (format) {
+            case TexFormat::BC1:
+                encodeBC1(tile, dst);
+                break;
+            case TexFormat::BC3:
+                encodeBC3(tile, dst);
+                break;
+            case TexFormat::ETC2_RGB8:
+                encodeETC1(tile, dst);
+                break;
+            case TexFormat::ASTC_4x4:
+                encodeASTC4x4(tile, dst);
+                break;
+            default:
+                break;
+            }
+        }
+    return out;
+}
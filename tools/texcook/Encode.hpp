@@ -0,0 +1,19 @@
+// tools/texcook/Encode.hpp
+#pragma once
+#include "Image.hpp"
+#include "graphics/TextureFormat.hpp"
+#include <cstdint>
+#include <vector>
+
+/*
+ * Block encoders. Each takes a 4x4 tile of RGBA8 texels (row-major) and
+ * writes one GPU block. Images whose size is not a multiple of 4 are
+ * padded by clamping to the edge texel.
+ */
+void encodeBC1(const uint8_t px[16][4], uint8_t out[8]);
+void encodeBC3(const uint8_t px[16][4], uint8_t out[16]);
+void encodeETC1(const uint8_t px[16][4], uint8_t out[8]); // valid ETC2 RGB8
+void encodeASTC4x4(const uint8_t px[16][4], uint8_t out[16]);
+
+/* Encodes a whole mip level; returns texLevelSize(format, w, h) bytes. */
+std::vector<uint8_t> encodeLevel(TexFormat format, const Image& img);
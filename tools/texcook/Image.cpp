@@ -0,0 +1,301 @@
+// tools/texcook/Image.cpp
+#include "Image.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+bool Image::hasAlpha() const
+{
+    for (size_t i = 3; i < rgba.size(); i += 4)
+        if (rgba[i] != 255)
+            return true;
+    return false;
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out)
+{
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    out.resize(size > 0 ? size_t(size) : 0);
+    bool ok = size > 0 && std::fread(out.data(), 1, out.size(), f) == out.size();
+    std::fclose(f);
+    return ok;
+}
+
+/* -------------------------------- TGA ---------------------------------- */
+static bool loadTGA(const std::vector<uint8_t>& d, Image& out, std::string* error)
+{
+    if (d.size() < 18) {
+        *error = "truncated TGA header";
+        return false;
+    }
+    int idLen = d[0];
+    int cmapType = d[1];
+    int imgType = d[2];
+    int w = d[12] | (d[13] << 8);
+    int h = d[14] | (d[15] << 8);
+    int bpp = d[16];
+    bool topDown = (d[17] & 0x20) != 0;
+    bool rle = imgType == 10;
+
+    if (cmapType != 0 || (imgType != 2 && imgType != 10) || (bpp != 24 && bpp != 32)) {
+        *error = "only true-colour 24/32-bit TGA is supported";
+        return false;
+    }
+    size_t cmapBytes = size_t(d[5] | (d[6] << 8)) * ((d[7] + 7) / 8);
+    size_t pos = 18 + idLen + cmapBytes;
+    int bytesPP = bpp / 8;
+
+    out.width = w;
+    out.height = h;
+    out.rgba.assign(size_t(w) * h * 4, 255);
+
+    auto readPixel = [&](uint8_t* dst) {
+        if (pos + bytesPP > d.size())
+            return false;
+        dst[0] = d[pos + 2];
+        dst[1] = d[pos + 1];
+        dst[2] = d[pos + 0];
+        dst[3] = bytesPP == 4 ? d[pos + 3] : 255;
+        pos += bytesPP;
+        return true;
+    };
+
+    size_t count = size_t(w) * h;
+    std::vector<uint8_t> linear(count * 4);
+    auto truncated = [&]() {
+        *error = "truncated TGA pixel data";
+        return false;
+    };
+    for (size_t i = 0; i < count;) {
+        if (!rle) {
+            if (!readPixel(&linear[i * 4]))
+                return truncated();
+            ++i;
+            continue;
+        }
+        if (pos >= d.size())
+            return truncated();
+        uint8_t hdr = d[pos++];
+        size_t run = (hdr & 0x7F) + 1;
+        if (hdr & 0x80) {
+            uint8_t px[4];
+            if (!readPixel(px))
+                return truncated();
+            for (size_t k = 0; k < run && i < count; ++k, ++i)
+                std::memcpy(&linear[i * 4], px, 4);
+        } else {
+            for (size_t k = 0; k < run && i < count; ++k, ++i)
+                if (!readPixel(&linear[i * 4]))
+                    return truncated();
+        }
+    }
+
+    for (int y = 0; y < h; ++y) {
+        int srcRow = topDown ? y : h - 1 - y;
+        std::memcpy(out.pixel(0, y), &linear[size_t(srcRow) * w * 4], size_t(w) * 4);
+    }
+    return true;
+}
+
+/* ----------------------------- PPM / PAM ------------------------------- */
+static bool loadPNM(const std::vector<uint8_t>& d, Image& out, std::string* error)
+{
+    size_t pos = 2;
+    auto token = [&]() {
+        std::string t;
+        while (pos < d.size()) {
+            char c = char(d[pos]);
+            if (c == '#') {
+                while (pos < d.size() && d[pos] != '\n')
+                    ++pos;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                if (!t.empty())
+                    break;
+                ++pos;
+            } else {
+                t += c;
+                ++pos;
+            }
+        }
+        return t;
+    };
+
+    int w = 0, h = 0, maxval = 0, depth = 3;
+    if (d[1] == '6') {
+        w = std::atoi(token().c_str());
+        h = std::atoi(token().c_str());
+        maxval = std::atoi(token().c_str());
+    } else {
+        for (std::string t = token(); !t.empty() && t != "ENDHDR"; t = token()) {
+            if (t == "WIDTH")
+                w = std::atoi(token().c_str());
+            else if (t == "HEIGHT")
+                h = std::atoi(token().c_str());
+            else if (t == "DEPTH")
+                depth = std::atoi(token().c_str());
+            else if (t == "MAXVAL")
+                maxval = std::atoi(token().c_str());
+        }
+    }
+    ++pos; // single whitespace before the raster
+
+    if (w <= 0 || h <= 0 || maxval != 255 || (depth != 3 && depth != 4)) {
+        *error = "only 8-bit RGB/RGBA PPM/PAM is supported";
+        return false;
+    }
+    if (pos + size_t(w) * h * depth > d.size()) {
+        *error = "truncated raster";
+        return false;
+    }
+
+    out.width = w;
+    out.height = h;
+    out.rgba.resize(size_t(w) * h * 4);
+    for (size_t i = 0; i < size_t(w) * h; ++i) {
+        const uint8_t* src = &d[pos + i * depth];
+        uint8_t* dst = &out.rgba[i * 4];
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = depth == 4 ? src[3] : 255;
+    }
+    return true;
+}
+
+bool loadImage(const std::string& path, Image& out, std::string* error)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data)) {
+        *error = "cannot read file";
+        return false;
+    }
+    if (data.size() > 2 && data[0] == 'P' && (data[1] == '6' || data[1] == '7'))
+        return loadPNM(data, out, error);
+    return loadTGA(data, out, error);
+}
+
+/* ------------------------------ mipmaps -------------------------------- */
+static float srgbToLinear(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSrgb(float c)
+{
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+}
+
+// Working format: premultiplied RGBA floats, linear when sRGB.
+struct FloatImage {
+    int width, height;
+    std::vector<float> px;
+};
+
+static FloatImage toFloat(const Image& img, bool srgb)
+{
+    FloatImage f { img.width, img.height, std::vector<float>(img.rgba.size()) };
+    float lut[256];
+    for (int i = 0; i < 256; ++i)
+        lut[i] = srgb ? srgbToLinear(i / 255.f) : i / 255.f;
+    for (size_t i = 0; i < img.rgba.size(); i += 4) {
+        float a = img.rgba[i + 3] / 255.f;
+        f.px[i + 0] = lut[img.rgba[i + 0]] * a;
+        f.px[i + 1] = lut[img.rgba[i + 1]] * a;
+        f.px[i + 2] = lut[img.rgba[i + 2]] * a;
+        f.px[i + 3] = a;
+    }
+    return f;
+}
+
+static Image toBytes(const FloatImage& f, bool srgb)
+{
+    Image img;
+    img.width = f.width;
+    img.height = f.height;
+    img.rgba.resize(f.px.size());
+    auto q = [](float v) {
+        return uint8_t(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+    };
+    for (size_t i = 0; i < f.px.size(); i += 4) {
+        float a = f.px[i + 3];
+        for (int c = 0; c < 3; ++c) {
+            float v = a > 0.f ? f.px[i + c] / a : 0.f;
+            img.rgba[i + c] = q(srgb ? linearToSrgb(std::clamp(v, 0.f, 1.f)) : v);
+        }
+        img.rgba[i + 3] = q(a);
+    }
+    return img;
+}
+
+// Source span [begin, end) covered by dst texel i, with per-texel weights.
+struct Footprint {
+    int first;
+    std::vector<float> weights;
+};
+
+static std::vector<Footprint> footprints(int srcSize, int dstSize)
+{
+    std::vector<Footprint> fps(dstSize);
+    float scale = float(srcSize) / float(dstSize);
+    for (int i = 0; i < dstSize; ++i) {
+        float b = i * scale, e = (i + 1) * scale;
+        int first = int(std::floor(b));
+        int last = std::min(srcSize - 1, int(std::ceil(e)) - 1);
+        fps[i].first = first;
+        for (int s = first; s <= last; ++s) {
+            float cover = std::min(e, float(s + 1)) - std::max(b, float(s));
+            fps[i].weights.push_back(cover / scale);
+        }
+    }
+    return fps;
+}
+
+static FloatImage downsample(const FloatImage& src)
+{
+    int dw = std::max(1, src.width / 2);
+    int dh = std::max(1, src.height / 2);
+    auto fx = footprints(src.width, dw);
+    auto fy = footprints(src.height, dh);
+
+    // separable: horizontal pass into tmp, then vertical
+    std::vector<float> tmp(size_t(dw) * src.height * 4, 0.f);
+    for (int y = 0; y < src.height; ++y)
+        for (int x = 0; x < dw; ++x)
+            for (size_t k = 0; k < fx[x].weights.size(); ++k) {
+                const float* s = &src.px[(size_t(y) * src.width + fx[x].first + k) * 4];
+                float* t = &tmp[(size_t(y) * dw + x) * 4];
+                for (int c = 0; c < 4; ++c)
+                    t[c] += s[c] * fx[x].weights[k];
+            }
+
+    FloatImage dst { dw, dh, std::vector<float>(size_t(dw) * dh * 4, 0.f) };
+    for (int y = 0; y < dh; ++y)
+        for (size_t k = 0; k < fy[y].weights.size(); ++k)
+            for (int x = 0; x < dw; ++x) {
+                const float* t = &tmp[(size_t(fy[y].first + k) * dw + x) * 4];
+                float* d = &dst.px[(size_t(y) * dw + x) * 4];
+                for (int c = 0; c < 4; ++c)
+                    d[c] += t[c] * fy[y].weights[k];
+            }
+    return dst;
+}
+
+std::vector<Image> buildMipChain(const Image& img, bool srgb, int maxLevels)
+{
+    std::vector<Image> chain { img };
+    FloatImage cur = toFloat(img, srgb);
+    while ((cur.width > 1 || cur.height > 1) && int(chain.size()) < maxLevels) {
+        cur = downsample(cur);
+        chain.push_back(toBytes(cur, srgb));
+    }
+    return chain;
+}
@@ -0,0 +1,28 @@
+// tools/texcook/Image.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* 8-bit RGBA image, rows top to bottom. */
+struct Image {
+    int width { 0 };
+    int height { 0 };
+    std::vector<uint8_t> rgba;
+
+    uint8_t* pixel(int x, int y) { return &rgba[(size_t(y) * width + x) * 4]; }
+    const uint8_t* pixel(int x, int y) const { return &rgba[(size_t(y) * width + x) * 4]; }
+    bool hasAlpha() const;
+};
+
+/* Loads uncompressed / RLE TGA (24/32 bit) and binary PPM (P6) or PAM (P7). */
+bool loadImage(const std::string& path, Image& out, std::string* error);
+
+/*
+ * Builds the mip chain for img (level 0 included), down to 1x1 or until
+ * maxLevels is reached. Each level is filtered from the previous one with
+ * an exact area-weighted box, so odd sizes do not shift or drop texels.
+ * Filtering happens on alpha-premultiplied values, in linear light when
+ * srgb is set.
+ */
+std::vector<Image> buildMipChain(const Image& img, bool srgb, int maxLevels);
@@ -0,0 +1,201 @@
+// tools/texcook/main.cpp
+//
+// Host-side texture cooker: turns TGA/PPM images into .gtex files that
+// Texture::loadFromFile uploads without decoding.
+//
+//   texcook [options] -o out.gtex image.tga
+//   texcook [options] --atlas -o out.gtex a.tga b.tga ...
+#include "Atlas.hpp"
+#include "Encode.hpp"
+#include "Image.hpp"
+#include "graphics/TextureFormat.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void usage()
+{
+    std::fprintf(stderr,
+        "usage: texcook [options] -o <out.gtex> <image> [images...]\n"
+        "  -f, --format <fmt>  astc (default), bc1, bc3, etc2, rgba8\n"
+        "  -o <file>           output file\n"
+        "      --atlas         pack all inputs into one atlas with a UV table\n"
+        "      --padding <n>   atlas gutter in texels (default 4)\n"
+        "      --max-size <n>  largest atlas edge (default 2048)\n"
+        "      --linear        data texture: filter mips without sRGB decode\n"
+        "      --no-mips       only write level 0\n");
+}
+
+static bool parseFormat(const char* s, TexFormat& out)
+{
+    struct {
+        const char* name;
+        TexFormat fmt;
+    } table[] = {
+        { "astc", TexFormat::ASTC_4x4 },
+        { "bc1", TexFormat::BC1 },
+        { "bc3", TexFormat::BC3 },
+        { "etc2", TexFormat::ETC2_RGB8 },
+        { "rgba8", TexFormat::RGBA8 },
+    };
+    for (const auto& e : table)
+        if (std::strcmp(s, e.name) == 0) {
+            out = e.fmt;
+            return true;
+        }
+    return false;
+}
+
+static std::string fileStem(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+static uint32_t align16(uint32_t v) { return (v + 15u) & ~15u; }
+
+static bool writeTexture(const std::string& path, TexFormat format, uint8_t flags,
+    const std::vector<Image>& mips, const std::vector<TexAtlasRegion>& regions)
+{
+    std::vector<std::vector<uint8_t>> payloads;
+    for (const Image& level : mips)
+        payloads.push_back(encodeLevel(format, level));
+
+    TexFileHeader hdr {};
+    hdr.magic = kTexMagic;
+    hdr.version = kTexVersion;
+    hdr.format = uint16_t(format);
+    hdr.width = uint16_t(mips[0].width);
+    hdr.height = uint16_t(mips[0].height);
+    hdr.mipCount = uint8_t(mips.size());
+    hdr.flags = flags;
+    hdr.regionCount = uint16_t(regions.size());
+    hdr.regionOffset = uint32_t(sizeof(hdr) + mips.size() * sizeof(TexMipLevel));
+
+    std::vector<TexMipLevel> table(mips.size());
+    uint32_t offset = align16(hdr.regionOffset + uint32_t(regions.size() * sizeof(TexAtlasRegion)));
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        table[i] = { offset, uint32_t(payloads[i].size()) };
+        offset = align16(offset + table[i].size);
+    }
+    hdr.dataSize = offset;
+
+    std::vector<uint8_t> file(offset, 0);
+    std::memcpy(file.data(), &hdr, sizeof(hdr));
+    std::memcpy(file.data() + sizeof(hdr), table.data(), table.size() * sizeof(TexMipLevel));
+    if (!regions.empty())
+        std::memcpy(file.data() + hdr.regionOffset, regions.data(),
+            regions.size() * sizeof(TexAtlasRegion));
+    for (size_t i = 0; i < payloads.size(); ++i)
+        std::memcpy(file.data() + table[i].offset, payloads[i].data(), payloads[i].size());
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = std::fwrite(file.data(), 1, file.size(), f) == file.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+int main(int argc, char** argv)
+{
+    TexFormat format = TexFormat::ASTC_4x4;
+    std::string outPath;
+    std::vector<std::string> inputs;
+    bool atlas = false, srgb = true, mips = true;
+    int padding = 4, maxSize = 2048;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((a == "-f" || a == "--format") && hasValue) {
+            if (!parseFormat(argv[++i], format)) {
+                std::fprintf(stderr, "texcook: unknown format '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (a == "-o" && hasValue) {
+            outPath = argv[++i];
+        } else if (a == "--padding" && hasValue) {
+            padding = std::atoi(argv[++i]);
+        } else if (a == "--max-size" && hasValue) {
+            maxSize = std::atoi(argv[++i]);
+        } else if (a == "--atlas") {
+            atlas = true;
+        } else if (a == "--linear") {
+            srgb = false;
+        } else if (a == "--no-mips") {
+            mips = false;
+        } else if (!a.empty() && a[0] == '-') {
+            usage();
+            return 1;
+        } else {
+            inputs.push_back(a);
+        }
+    }
+    if (outPath.empty() || inputs.empty() || (!atlas && inputs.size() != 1) || padding < 0) {
+        usage();
+        return 1;
+    }
+
+    std::vector<AtlasInput> images(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::string err;
+        if (!loadImage(inputs[i], images[i].image, &err)) {
+            std::fprintf(stderr, "texcook: %s: %s\n", inputs[i].c_str(), err.c_str());
+            return 1;
+        }
+        images[i].name = fileStem(inputs[i]);
+    }
+
+    // from the inputs, not the atlas: its unused area is transparent
+    bool alpha = false;
+    for (const AtlasInput& in : images)
+        alpha = alpha || in.image.hasAlpha();
+
+    Image base;
+    std::vector<TexAtlasRegion> regions;
+    int maxLevels = mips ? kTexMaxMips : 1;
+    if (atlas) {
+        Atlas packed;
+        std::string err;
+        if (!packAtlas(images, padding, maxSize, packed, &err)) {
+            std::fprintf(stderr, "texcook: %s\n", err.c_str());
+            return 1;
+        }
+        base = std::move(packed.image);
+        regions = std::move(packed.regions);
+        // level L shrinks the gutter to padding >> L texels; stop before it
+        // would let neighbours bleed into each other
+        int safe = 1;
+        for (int p = padding; p > 1; p /= 2)
+            ++safe;
+        if (maxLevels > safe)
+            maxLevels = safe;
+    } else {
+        base = std::move(images[0].image);
+    }
+
+    if (base.width > 65535 || base.height > 65535) {
+        std::fprintf(stderr, "texcook: image too large\n");
+        return 1;
+    }
+
+    if (alpha && (format == TexFormat::BC1 || format == TexFormat::ETC2_RGB8))
+        std::fprintf(stderr, "texcook: warning: %s drops the alpha channel\n",
+            format == TexFormat::BC1 ? "bc1" : "etc2");
+
+    std::vector<Image> chain = buildMipChain(base, srgb, maxLevels);
+    uint8_t flags = uint8_t((srgb ? TexFlag_SRGB : 0) | (alpha ? TexFlag_Alpha : 0));
+    if (!writeTexture(outPath, format, flags, chain, regions)) {
+        std::fprintf(stderr, "texcook: cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+
+    std::printf("texcook: %s  %dx%d  %zu mips  %zu regions\n", outPath.c_str(),
+        base.width, base.height, chain.size(), regions.size());
+    return 0;
+}
@@ -0,0 +1,252 @@
+// tools/texcook/test/EncodeTest.cpp
+//
+// Round-trip checks for the block encoders: encode a 4x4 tile, decode it
+// again with a minimal reference decoder and compare against the input.
+//
+//   g++ -std=c++17 -Isource -Itools/texcook tools/texcook/test/EncodeTest.cpp
+//       tools/texcook/Encode.cpp tools/texcook/Image.cpp -o encodetest && ./encodetest
+#include "Encode.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int s_failures = 0;
+
+static void check(bool ok, const char* what)
+{
+    std::printf("%s: %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok)
+        ++s_failures;
+}
+
+/* --------------------------- reference decoders ------------------------ */
+
+static void decodeBC1(const uint8_t in[8], uint8_t out[16][4])
+{
+    const uint16_t c0 = uint16_t(in[0] | in[1] << 8), c1 = uint16_t(in[2] | in[3] << 8);
+    int pal[4][3];
+    const uint16_t c[2] = { c0, c1 };
+    for (int k = 0; k < 2; ++k) {
+        int r = (c[k] >> 11) & 31, g = (c[k] >> 5) & 63, b = c[k] & 31;
+        pal[k][0] = (r << 3) | (r >> 2);
+        pal[k][1] = (g << 2) | (g >> 4);
+        pal[k][2] = (b << 3) | (b >> 2);
+    }
+    for (int ch = 0; ch < 3; ++ch) {
+        if (c0 > c1) {
+            pal[2][ch] = (2 * pal[0][ch] + pal[1][ch]) / 3;
+            pal[3][ch] = (pal[0][ch] + 2 * pal[1][ch]) / 3;
+        } else {
+            pal[2][ch] = (pal[0][ch] + pal[1][ch]) / 2;
+            pal[3][ch] = 0;
+        }
+    }
+    const uint32_t idx = uint32_t(in[4] | in[5] << 8 | in[6] << 16 | uint32_t(in[7]) << 24);
+    for (int i = 0; i < 16; ++i) {
+        const int k = (idx >> (2 * i)) & 3;
+        for (int ch = 0; ch < 3; ++ch)
+            out[i][ch] = uint8_t(pal[k][ch]);
+        out[i][3] = 255;
+    }
+}
+
+// Alpha half of a BC3 block (the same layout as BC4).
+static void decodeBC3Alpha(const uint8_t in[8], uint8_t out[16][4])
+{
+    const int a0 = in[0], a1 = in[1];
+    int pal[8] = { a0, a1 };
+    for (int k = 2; k < 8; ++k)
+        pal[k] = a0 > a1 ? ((8 - k) * a0 + (k - 1) * a1) / 7 : k < 6 ? ((6 - k) * a0 + (k - 1) * a1) / 5 : k == 6 ? 0 : 255;
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; ++b)
+        bits |= uint64_t(in[2 + b]) << (8 * b);
+    for (int i = 0; i < 16; ++i)
+        out[i][3] = uint8_t(pal[(bits >> (3 * i)) & 7]);
+}
+
+// ETC1 individual and differential modes; a differential base that leaves
+// 0..31 is an ETC2-only mode and rejected.
+static bool decodeETC1(const uint8_t in[8], uint8_t out[16][4])
+{
+    static const int kModifiers[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 },
+        { 24, 80 }, { 33, 106 }, { 47, 183 } };
+    uint64_t block = 0;
+    for (int b = 0; b < 8; ++b)
+        block = block << 8 | in[b];
+    const bool diff = (block >> 33) & 1, flip = (block >> 32) & 1;
+
+    int base[2][3];
+    for (int c = 0; c < 3; ++c) {
+        const int shift = 59 - 8 * c;
+        if (diff) {
+            const int b0 = int(block >> shift) & 31;
+            int d = int(block >> (shift - 3)) & 7; // 3-bit two's complement
+            if (d >= 4)
+                d -= 8;
+            const int b1 = b0 + d;
+            if (b1 < 0 || b1 > 31)
+                return false;
+            base[0][c] = (b0 << 3) | (b0 >> 2);
+            base[1][c] = (b1 << 3) | (b1 >> 2);
+        } else {
+            base[0][c] = (int(block >> (shift + 1)) & 15) * 17;
+            base[1][c] = (int(block >> (shift - 3)) & 15) * 17;
+        }
+    }
+    const int table[2] = { int(block >> 37) & 7, int(block >> 34) & 7 };
+
+    for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x) {
+            const int s = flip ? y >= 2 : x >= 2;
+            const int j = x * 4 + y;
+            const int msb = int(block >> (16 + j)) & 1, lsb = int(block >> j) & 1;
+            const int mag = kModifiers[table[s]][lsb];
+            for (int c = 0; c < 3; ++c)
+                out[y * 4 + x][c] = uint8_t(std::clamp(base[s][c] + (msb ? -mag : mag), 0, 255));
+            out[y * 4 + x][3] = 255;
+        }
+    return true;
+}
+
+static uint32_t getBits(const uint8_t block[16], int pos, int count)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < count; ++i)
+        if (block[(pos + i) >> 3] & (1u << ((pos + i) & 7)))
+            v |= 1u << i;
+    return v;
+}
+
+// Only the fixed configuration encodeASTC4x4 writes (see Encode.cpp).
+static bool decodeASTC4x4(const uint8_t in[16], uint8_t out[16][4])
+{
+    static const int kWeights[4] = { 0, 21, 43, 64 };
+    if (getBits(in, 0, 11) != 0x042 || getBits(in, 13, 4) != 12)
+        return false;
+    int e[2][4];
+    for (int c = 0; c < 4; ++c) {
+        e[0][c] = int(getBits(in, 17 + 16 * c, 8));
+        e[1][c] = int(getBits(in, 17 + 16 * c + 8, 8));
+    }
+    if (e[1][0] + e[1][1] + e[1][2] < e[0][0] + e[0][1] + e[0][2])
+        return false; // blue contraction is never emitted
+    for (int i = 0; i < 16; ++i) {
+        const int w = kWeights[getBits(in, 127 - 2 * i, 1) | getBits(in, 126 - 2 * i, 1) << 1];
+        for (int c = 0; c < 4; ++c) {
+            const int c0 = e[0][c] * 257, c1 = e[1][c] * 257;
+            out[i][c] = uint8_t(((c0 * (64 - w) + c1 * w + 32) >> 6) >> 8);
+        }
+    }
+    return true;
+}
+
+/* -------------------------------- tests -------------------------------- */
+
+static int maxError(const uint8_t a[16][4], const uint8_t b[16][4], int channels)
+{
+    int worst = 0;
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < channels; ++c)
+            worst = std::max(worst, std::abs(a[i][c] - b[i][c]));
+    return worst;
+}
+
+// Left half one colour, right half the other.
+static void splitBlock(const uint8_t a[4], const uint8_t b[4], uint8_t px[16][4])
+{
+    for (int i = 0; i < 16; ++i)
+        std::memcpy(px[i], (i & 3) < 2 ? a : b, 4);
+}
+
+static void testOrthogonal(const char* name, const uint8_t a[4], const uint8_t b[4])
+{
+    uint8_t px[16][4], decoded[16][4];
+    splitBlock(a, b, px);
+    char what[128];
+
+    uint8_t bc1[8];
+    encodeBC1(px, bc1);
+    decodeBC1(bc1, decoded);
+    std::snprintf(what, sizeof(what), "BC1 %s round trip", name);
+    check(maxError(px, decoded, 3) <= 8, what);
+
+    uint8_t bc3[16];
+    encodeBC3(px, bc3);
+    decodeBC1(bc3 + 8, decoded);
+    std::snprintf(what, sizeof(what), "BC3 colour %s round trip", name);
+    check(maxError(px, decoded, 3) <= 8, what);
+
+    uint8_t astc[16];
+    encodeASTC4x4(px, astc);
+    std::snprintf(what, sizeof(what), "ASTC %s round trip", name);
+    check(decodeASTC4x4(astc, decoded) && maxError(px, decoded, 4) <= 2, what);
+}
+
+static void testETC1(const char* name, const uint8_t px[16][4], int tolerance)
+{
+    uint8_t etc[8], decoded[16][4];
+    encodeETC1(px, etc);
+    char what[128];
+    std::snprintf(what, sizeof(what), "ETC1 %s round trip", name);
+    check(decodeETC1(etc, decoded) && maxError(px, decoded, 3) <= tolerance, what);
+}
+
+static void testBC3Alpha(const char* name, const uint8_t px[16][4], int tolerance)
+{
+    uint8_t bc3[16], decoded[16][4];
+    encodeBC3(px, bc3);
+    decodeBC3Alpha(bc3, decoded);
+    int worst = 0;
+    for (int i = 0; i < 16; ++i)
+        worst = std::max(worst, std::abs(px[i][3] - decoded[i][3]));
+    char what[128];
+    std::snprintf(what, sizeof(what), "BC3 alpha %s round trip", name);
+    check(worst <= tolerance, what);
+}
+
+int main()
+{
+    // red/green and azure/orange vary orthogonally to (1,1,1), the old
+    // power-iteration start vector, and used to collapse to their mean
+    const uint8_t red[4] = { 255, 0, 0, 255 }, green[4] = { 0, 255, 0, 255 };
+    const uint8_t blue[4] = { 0, 0, 255, 255 }, yellow[4] = { 255, 255, 0, 255 };
+    const uint8_t azure[4] = { 0, 128, 255, 255 }, orange[4] = { 255, 128, 0, 255 };
+    const uint8_t grey[4] = { 90, 90, 90, 255 };
+    testOrthogonal("red/green", red, green);
+    testOrthogonal("azure/orange", azure, orange);
+    testOrthogonal("blue/yellow", blue, yellow);
+    testOrthogonal("flat", grey, grey);
+
+    // ETC1 halves are 2x4 side by side or 4x2 stacked (the flip bit); a
+    // half-block is one base colour plus a luminance-only modifier
+    uint8_t px[16][4];
+    splitBlock(red, green, px);
+    testETC1("red/green columns", px, 8);
+    for (int i = 0; i < 16; ++i)
+        std::memcpy(px[i], i < 8 ? azure : orange, 4);
+    testETC1("azure/orange rows", px, 8);
+    for (int i = 0; i < 16; ++i)
+        std::memcpy(px[i], grey, 4);
+    testETC1("flat", px, 4);
+    for (int i = 0; i < 16; ++i)
+        px[i][0] = px[i][1] = px[i][2] = uint8_t(96 + 8 * (i & 3)); // grey ramp along x
+    testETC1("luminance ramp", px, 8);
+
+    // alpha: eight-value palette, so a full ramp is within half a step
+    for (int i = 0; i < 16; ++i) {
+        std::memcpy(px[i], grey, 4);
+        px[i][3] = uint8_t(17 * i);
+    }
+    testBC3Alpha("ramp", px, 19);
+    for (int i = 0; i < 16; ++i)
+        px[i][3] = (i & 3) < 2 ? 0 : 255;
+    testBC3Alpha("cutout", px, 0);
+    for (int i = 0; i < 16; ++i)
+        px[i][3] = 128;
+    testBC3Alpha("constant", px, 0);
+
+    std::printf("%d failure(s)\n", s_failures);
+    return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}